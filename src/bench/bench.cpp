@@ -0,0 +1,404 @@
+/*
+NeuroPath micro-benchmarks
+
+Measures the hot paths of the maze core over a range of grid sizes and reports ns/cell, heap
+allocations and peak RSS. Results are printed as a table and written as JSON.
+
+Usage: neuropath_bench [--max-cells N] [--max-tiled-cells N] [--json FILE]
+
+The fixed-size maze (FixedMaze) is timed at 40x20 and 128x128 next to the dynamic path.
+Tiled generation only carves walls, so it is also timed on grids up to 16384x16384 that are too
+large for the full set (--max-tiled-cells).
+*/
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/fixed-maze.hpp"
+#include "maze-generator/maze-generator.hpp"
+#include "maze-generator/tiled-generation.hpp"
+#include "maze-geometry/ambient-occlusion.hpp"
+#include "solver/flow-field.hpp"
+#include "solver/maze-difficulty.hpp"
+#include "solver/maze-solver.hpp"
+#include "solver/tree-index.hpp"
+#include "utils/types.hpp"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+// windows.h must come first
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Allocation counters fed by the global operator new below
+static std::atomic<long long> allocation_count{0};
+static std::atomic<long long> allocation_bytes{0};
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Peak resident set size of the process in bytes
+long long peakRss() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<long long>(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return usage.ru_maxrss;  // bytes on macOS
+#else
+  return usage.ru_maxrss * 1024LL;  // kilobytes on Linux
+#endif
+#endif
+}
+
+struct GridSize {
+  int cols;
+  int rows;
+};
+
+// Result of one benchmark at one grid size
+struct BenchResult {
+  std::string name;
+  int cols;
+  int rows;
+  int iterations;
+  double ns_per_cell;
+  double allocations_per_iteration;
+  double bytes_per_iteration;
+  long long peak_rss;
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Time `body` over enough iterations to fill the minimum duration. `setup` runs before every
+// iteration and is excluded from the timing and the allocation counts.
+BenchResult runBench(const std::string& name, const GridSize& size,
+                     const std::function<void()>& setup, const std::function<void()>& body) {
+  const double min_seconds = 0.2;
+  const int max_iterations = 1000;
+
+  double total_ns = 0.0;
+  long long allocs = 0;
+  long long bytes = 0;
+  int iterations = 0;
+
+  while (iterations < max_iterations && (iterations == 0 || total_ns < min_seconds * 1e9)) {
+    setup();
+    const long long allocs_before = allocation_count.load();
+    const long long bytes_before = allocation_bytes.load();
+    const auto start = Clock::now();
+    body();
+    const auto end = Clock::now();
+    allocs += allocation_count.load() - allocs_before;
+    bytes += allocation_bytes.load() - bytes_before;
+    total_ns += std::chrono::duration<double, std::nano>(end - start).count();
+    iterations++;
+  }
+
+  const double cells = static_cast<double>(size.cols) * size.rows;
+  return {name,
+          size.cols,
+          size.rows,
+          iterations,
+          total_ns / iterations / cells,
+          static_cast<double>(allocs) / iterations,
+          static_cast<double>(bytes) / iterations,
+          peakRss()};
+}
+
+// Player-sized box standing on the floor in the middle of the maze
+AABB playerBox(const GridSize& size, const BoxSize3D& floor_dimension) {
+  const float x = (size.cols / 2) * floor_dimension.width;
+  const float z = (size.rows / 2) * floor_dimension.depth;
+  const float y = floor_dimension.height / 2;
+  return {{x - 0.15f, y - 0.01f, z - 0.15f}, {x + 0.15f, y + 1.0f, z + 0.15f}};
+}
+
+// Linear floor collision scan over every box
+int floorCollisionScan(const MazeGenerator& maze, const AABB& player) {
+  int hits = 0;
+  for (const auto& floor_bbox : maze.getFloorBBoxes()) {
+    if (checkCollision(player, floor_bbox)) {
+      hits++;
+      break;
+    }
+  }
+  return hits;
+}
+
+// Linear wall collision scan over every box
+int wallCollisionScan(const MazeGenerator& maze, const AABB& player) {
+  int hits = 0;
+  for (const auto& wall_bbox : maze.getWallBBoxes()) {
+    if (checkCollision(player, wall_bbox)) {
+      hits++;
+    }
+  }
+  return hits;
+}
+
+// Floor collision against the cell index, as done by the 3D view
+int floorCollisionIndexed(const MazeGenerator& maze, const AABB& player) {
+  int hits = 0;
+  maze.getFloorIndex().forEachNear(player, [&](const AABB& floor_bbox) {
+    if (!checkCollision(player, floor_bbox)) return false;
+    hits++;
+    return true;
+  });
+  return hits;
+}
+
+// Wall collision against the cell index, as done by the 3D view
+int wallCollisionIndexed(const MazeGenerator& maze, const AABB& player) {
+  int hits = 0;
+  maze.getWallIndex().forEachNear(player, [&](const AABB& wall_bbox) {
+    if (checkCollision(player, wall_bbox)) hits++;
+    return false;
+  });
+  return hits;
+}
+
+// Largest grid the mesh benchmarks run on
+constexpr long long MAX_GEOMETRY_CELLS = 128 * 128;
+
+void runSize(const GridSize& size, std::vector<BenchResult>& results) {
+  std::unique_ptr<MazeGenerator> maze;
+  volatile int sink = 0;
+
+  results.push_back(runBench(
+      "generate", size, [&] { maze = std::make_unique<MazeGenerator>(size.cols, size.rows); },
+      [&] { maze->finish_generation(); }));
+
+  // the remaining algorithms; DFS is the "generate" benchmark above
+  const GenerationAlgorithm algorithms[] = {GenerationAlgorithm::KRUSKAL, GenerationAlgorithm::PRIM,
+                                            GenerationAlgorithm::WILSON, GenerationAlgorithm::ELLER};
+  for (const GenerationAlgorithm algorithm : algorithms) {
+    std::unique_ptr<MazeGenerator> other;
+    results.push_back(runBench(
+        std::string("generate") + getAlgorithmName(algorithm), size,
+        [&] {
+          other = std::make_unique<MazeGenerator>(size.cols, size.rows);
+          other->setAlgorithm(algorithm);
+        },
+        [&] { other->finish_generation(); }));
+  }
+
+  results.push_back(runBench("calcPath", size, [] {}, [&] { maze->calcPath(); }));
+  results.push_back(runBench("analyzeMaze", size, [] {}, [&] {
+    sink = sink + analyzeMaze(maze->getGrid(), maze->getPath()).dead_ends;
+  }));
+
+  results.push_back(
+      runBench("calcBoundingBoxes", size, [] {}, [&] { maze->calcBoundingBoxes(); }));
+
+  const AABB player = playerBox(size, maze->getFloorDimension());
+  results.push_back(runBench(
+      "floorCollision", size, [] {}, [&] { sink = sink + floorCollisionScan(*maze, player); }));
+  results.push_back(runBench(
+      "wallCollision", size, [] {}, [&] { sink = sink + wallCollisionScan(*maze, player); }));
+  results.push_back(runBench("floorCollisionIndexed", size, [] {},
+                             [&] { sink = sink + floorCollisionIndexed(*maze, player); }));
+  results.push_back(runBench("wallCollisionIndexed", size, [] {},
+                             [&] { sink = sink + wallCollisionIndexed(*maze, player); }));
+
+  static ThreadPool pool;
+
+  // the meshes take about 40 bytes per cell and vertex, so they are only built on small grids
+  if (static_cast<long long>(size.cols) * size.rows <= MAX_GEOMETRY_CELLS) {
+    MazeGeometry geometry;
+    results.push_back(runBench("buildGeometry", size, [] {}, [&] { geometry.build(*maze); }));
+    results.push_back(runBench("bakeAO", size, [] {}, [&] {
+      bakeAmbientOcclusion(geometry, *maze);
+    }));
+    results.push_back(runBench("bakeAOParallel", size, [] {}, [&] {
+      bakeAmbientOcclusion(geometry, *maze, &pool);
+    }));
+  }
+
+  // corner to corner, the longest typical query
+  const MazeGrid& grid = maze->getGrid();
+  const std::pair<const char*, SolverAlgorithm> solvers[] = {
+      {"solveBFS", SolverAlgorithm::BFS},
+      {"solveAStar", SolverAlgorithm::A_STAR},
+      {"solveBidirectional", SolverAlgorithm::BIDIRECTIONAL_BFS}};
+  MazeSolver solver(grid);
+  std::vector<int> solved_path;
+  for (const auto& [name, algorithm] : solvers) {
+    results.push_back(runBench(name, size, [] {}, [&] {
+      solver.solve(0, grid.getCellCount() - 1, solved_path, algorithm);
+      sink = sink + static_cast<int>(solved_path.size());
+    }));
+  }
+
+  FlowField flow_field;
+  results.push_back(runBench("flowField", size, [] {}, [&] {
+    flow_field.build(grid, grid.getCellCount() - 1);
+  }));
+
+  std::unique_ptr<TreeIndex> tree_index;
+  results.push_back(runBench("treeIndexBuild", size, [&] { tree_index.reset(); },
+                             [&] { tree_index = std::make_unique<TreeIndex>(grid); }));
+  // one distance query per cell
+  results.push_back(runBench("treeDistance", size, [] {}, [&] {
+    int total = 0;
+    for (int cell = 0, other = grid.getCellCount() - 1; cell < grid.getCellCount();
+         ++cell, --other) {
+      total += tree_index->getDistance(cell, other);
+    }
+    sink = sink + total;
+  }));
+
+  // 256 random queries spread over every core
+  std::vector<SolveQuery> queries(256);
+  std::mt19937 rng(1);
+  for (SolveQuery& query : queries) {
+    query = {static_cast<int>(rng() % grid.getCellCount()),
+             static_cast<int>(rng() % grid.getCellCount())};
+  }
+  results.push_back(runBench("solveBatch256", size, [] {}, [&] {
+    sink = sink + static_cast<int>(solveBatch(grid, queries, pool).size());
+  }));
+}
+
+// Time tiled generation on the calling thread and on every core
+void runTiledSize(const GridSize& size, std::vector<BenchResult>& results) {
+  static ThreadPool pool;
+  std::unique_ptr<MazeGrid> grid;
+  auto setup = [&] {
+    grid.reset();  // free the previous grid before allocating the next one
+    grid = std::make_unique<MazeGrid>(size.cols, size.rows);
+  };
+  results.push_back(runBench("generateTiledSerial", size, setup, [&] {
+    generateTiledMaze(*grid, GenerationAlgorithm::DFS, 1);
+  }));
+  results.push_back(runBench("generateTiledParallel", size, setup, [&] {
+    generateTiledMaze(*grid, GenerationAlgorithm::DFS, 1, &pool);
+  }));
+}
+
+// Time the compile-time sized maze, to compare with "generate" and "solveBFS" at the same size
+template <int Cols, int Rows>
+void runFixedSize(std::vector<BenchResult>& results) {
+  using Maze = FixedMaze<Cols, Rows>;
+  const GridSize size = {Cols, Rows};
+  auto maze = std::make_unique<Maze>();
+  auto path = std::make_unique<std::array<int, Maze::CELLS>>();
+  volatile int sink = 0;
+  uint32_t seed = 1;
+  results.push_back(runBench("generateFixed", size, [] {}, [&] { maze->generate(seed++); }));
+  results.push_back(runBench("solveFixed", size, [] {}, [&] {
+    sink = sink + maze->solve(0, Maze::CELLS - 1, *path);
+  }));
+}
+
+bool writeJson(const std::string& file_name, const std::vector<BenchResult>& results) {
+  FILE* file = std::fopen(file_name.c_str(), "w");
+  if (!file) return false;
+
+  std::fprintf(file, "{\n  \"benchmarks\": [\n");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const BenchResult& r = results[i];
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"cols\": %d, \"rows\": %d, \"iterations\": %d, "
+                 "\"ns_per_cell\": %.4f, \"allocations\": %.1f, \"allocated_bytes\": %.0f, "
+                 "\"peak_rss_bytes\": %lld}%s\n",
+                 r.name.c_str(), r.cols, r.rows, r.iterations, r.ns_per_cell,
+                 r.allocations_per_iteration, r.bytes_per_iteration, r.peak_rss,
+                 i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  std::fclose(file);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  long long max_cells = 4096LL * 4096LL;
+  long long max_tiled_cells = 16384LL * 16384LL;
+  std::string json_file = "bench_results.json";
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--max-cells") == 0 && i + 1 < argc) {
+      max_cells = std::atoll(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-tiled-cells") == 0 && i + 1 < argc) {
+      max_tiled_cells = std::atoll(argv[++i]);
+    } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      json_file = argv[++i];
+    } else {
+      std::fprintf(stderr, "Usage: %s [--max-cells N] [--max-tiled-cells N] [--json FILE]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  const std::vector<GridSize> sizes = {
+      {40, 20}, {128, 128}, {512, 512}, {1024, 1024}, {4096, 4096}};
+
+  std::vector<BenchResult> results;
+  std::printf("%-22s %11s %8s %12s %14s %12s\n", "benchmark", "grid", "iters", "ns/cell",
+              "allocs/iter", "peak RSS MB");
+  auto printFrom = [&](std::size_t first) {
+    for (std::size_t i = first; i < results.size(); ++i) {
+      const BenchResult& r = results[i];
+      std::printf("%-22s %5dx%-5d %8d %12.3f %14.1f %12.1f\n", r.name.c_str(), r.cols, r.rows,
+                  r.iterations, r.ns_per_cell, r.allocations_per_iteration,
+                  r.peak_rss / (1024.0 * 1024.0));
+    }
+  };
+  for (const GridSize& size : sizes) {
+    if (static_cast<long long>(size.cols) * size.rows > max_cells) continue;
+
+    const std::size_t first = results.size();
+    runSize(size, results);
+    printFrom(first);
+  }
+
+  // the fixed sizes are template arguments, matching the first two dynamic sizes
+  const std::size_t first_fixed = results.size();
+  runFixedSize<40, 20>(results);
+  runFixedSize<128, 128>(results);
+  printFrom(first_fixed);
+
+  const std::vector<GridSize> tiled_sizes = {{1024, 1024}, {4096, 4096}, {16384, 16384}};
+  for (const GridSize& size : tiled_sizes) {
+    if (static_cast<long long>(size.cols) * size.rows > max_tiled_cells) continue;
+
+    const std::size_t first = results.size();
+    runTiledSize(size, results);
+    printFrom(first);
+  }
+
+  if (!writeJson(json_file, results)) {
+    std::fprintf(stderr, "Failed to write %s\n", json_file.c_str());
+    return 1;
+  }
+  std::printf("Results written to %s\n", json_file.c_str());
+  return 0;
+}
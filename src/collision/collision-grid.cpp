@@ -0,0 +1,48 @@
+#include "collision-grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void CollisionGrid::cellRange(const AABB& box, int& x0, int& z0, int& x1, int& z1) const {
+  x0 = std::clamp(static_cast<int>(std::floor((box.min.x - origin.x) / cell_width)), 0, cols - 1);
+  x1 = std::clamp(static_cast<int>(std::floor((box.max.x - origin.x) / cell_width)), 0, cols - 1);
+  z0 = std::clamp(static_cast<int>(std::floor((box.min.z - origin.z) / cell_depth)), 0, rows - 1);
+  z1 = std::clamp(static_cast<int>(std::floor((box.max.z - origin.z) / cell_depth)), 0, rows - 1);
+}
+
+void CollisionGrid::build(std::vector<AABB> boxes, int cols, int rows, float cell_width,
+                          float cell_depth, const Vec3& origin) {
+  this->boxes = std::move(boxes);
+  this->cols = cols;
+  this->rows = rows;
+  this->cell_width = cell_width;
+  this->cell_depth = cell_depth;
+  this->origin = origin;
+
+  // count the boxes of every cell, then fill the buckets (compressed sparse rows)
+  offsets.assign(static_cast<std::size_t>(cols) * rows + 1, 0);
+  for (const AABB& box : this->boxes) {
+    int x0, z0, x1, z1;
+    cellRange(box, x0, z0, x1, z1);
+    for (int z = z0; z <= z1; ++z) {
+      for (int x = x0; x <= x1; ++x) {
+        offsets[z * cols + x + 1]++;
+      }
+    }
+  }
+  for (std::size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+
+  box_indices.resize(offsets.back());
+  std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+  for (int i = 0; i < static_cast<int>(this->boxes.size()); ++i) {
+    int x0, z0, x1, z1;
+    cellRange(this->boxes[i], x0, z0, x1, z1);
+    for (int z = z0; z <= z1; ++z) {
+      for (int x = x0; x <= x1; ++x) {
+        box_indices[cursor[z * cols + x]++] = i;
+      }
+    }
+  }
+}
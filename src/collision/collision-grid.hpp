@@ -0,0 +1,51 @@
+/*
+Collision Grid - Uniform-grid spatial index
+
+Buckets bounding boxes by the maze cells they overlap, so a collision query only visits the
+boxes stored in the few cells the query box touches instead of every box in the maze.
+*/
+#pragma once
+
+#include <vector>
+
+#include "utils/types.hpp"
+
+// CollisionGrid class indexing bounding boxes by maze cell
+class CollisionGrid {
+  int cols = 0;                  // number of cells along x
+  int rows = 0;                  // number of cells along z
+  float cell_width = 1.0f;       // size of a cell along x
+  float cell_depth = 1.0f;       // size of a cell along z
+  Vec3 origin = {0, 0, 0};       // world position of the min corner of cell (0, 0)
+  std::vector<AABB> boxes;       // indexed boxes
+  std::vector<int> offsets;      // start of each cell's bucket in box_indices (cols * rows + 1)
+  std::vector<int> box_indices;  // boxes overlapping each cell, bucket after bucket
+
+  // Get the clamped cell range covered by a box
+  void cellRange(const AABB& box, int& x0, int& z0, int& x1, int& z1) const;
+
+ public:
+  // Index the boxes over a grid of cols x rows cells whose cell (0, 0) starts at origin
+  void build(std::vector<AABB> boxes, int cols, int rows, float cell_width, float cell_depth,
+             const Vec3& origin);
+
+  const std::vector<AABB>& getBoxes() const { return boxes; }
+
+  // Call fn for every box stored in the cells overlapped by the query box. A box spanning
+  // several cells may be visited more than once. Stops early when fn returns true.
+  template <typename Fn>
+  void forEachNear(const AABB& query, Fn&& fn) const {
+    if (boxes.empty()) return;
+
+    int x0, z0, x1, z1;
+    cellRange(query, x0, z0, x1, z1);
+    for (int z = z0; z <= z1; ++z) {
+      for (int x = x0; x <= x1; ++x) {
+        const int cell = z * cols + x;
+        for (int i = offsets[cell]; i < offsets[cell + 1]; ++i) {
+          if (fn(boxes[box_indices[i]])) return;
+        }
+      }
+    }
+  }
+};
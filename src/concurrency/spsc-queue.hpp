@@ -0,0 +1,67 @@
+/*
+SPSC Queue - Lock-free single-producer single-consumer ring buffer
+
+One thread pushes and one other thread pops; neither ever blocks or takes a lock. The capacity is
+rounded up to a power of two. Each side caches the other side's index, so the shared indices are
+only re-read when the queue looks full (producer) or empty (consumer).
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// SpscQueue class passing values from one producer thread to one consumer thread
+template <typename T>
+class SpscQueue {
+  static constexpr std::size_t CACHE_LINE = 64;  // keeps the two sides on separate cache lines
+
+  std::vector<T> slots;  // ring storage
+  std::size_t mask;      // capacity - 1
+
+  alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};  // next slot to write (producer)
+  std::size_t cached_head = 0;                           // producer's copy of head
+  alignas(CACHE_LINE) std::atomic<std::size_t> head{0};  // next slot to read (consumer)
+  std::size_t cached_tail = 0;                           // consumer's copy of tail
+
+  static std::size_t roundUpPowerOfTwo(std::size_t value) {
+    std::size_t capacity = 1;
+    while (capacity < value) capacity <<= 1;
+    return capacity;
+  }
+
+ public:
+  explicit SpscQueue(std::size_t capacity)
+      : slots(roundUpPowerOfTwo(capacity)), mask(slots.size() - 1) {}
+
+  std::size_t getCapacity() const { return slots.size(); }
+
+  // Append a value; returns false if the queue is full (producer only)
+  bool tryPush(const T& value) {
+    const std::size_t t = tail.load(std::memory_order_relaxed);
+    if (t - cached_head == slots.size()) {
+      cached_head = head.load(std::memory_order_acquire);
+      if (t - cached_head == slots.size()) return false;
+    }
+    slots[t & mask] = value;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Take the oldest value; returns false if the queue is empty (consumer only)
+  bool tryPop(T& value) {
+    const std::size_t h = head.load(std::memory_order_relaxed);
+    if (h == cached_tail) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (h == cached_tail) return false;
+    }
+    value = slots[h & mask];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Check whether every pushed value was popped (consumer only)
+  bool empty() const {
+    return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+  }
+};
@@ -0,0 +1,78 @@
+#include "thread-pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(int thread_count) {
+  if (thread_count <= 0) {
+    thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  }
+  workers.reserve(thread_count);
+  for (int i = 0; i < thread_count; ++i) {
+    workers.emplace_back([this] { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    jobs.clear();
+  }
+  job_available.notify_all();
+  for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(std::move(job));
+  }
+  job_available.notify_one();
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int begin, int end)>& body) {
+  const int parts = std::min(count, getThreadCount() + 1);
+  if (parts <= 1) {
+    if (count > 0) body(0, count);
+    return;
+  }
+
+  std::mutex done_mutex;
+  std::condition_variable done;
+  int remaining = parts - 1;
+  for (int part = 1; part < parts; ++part) {
+    const int begin = static_cast<int>(static_cast<long long>(count) * part / parts);
+    const int end = static_cast<int>(static_cast<long long>(count) * (part + 1) / parts);
+    submit([&, begin, end] {
+      body(begin, end);
+      // notify under the lock: the waiting caller owns `done` and may return right after
+      std::lock_guard<std::mutex> lock(done_mutex);
+      remaining--;
+      done.notify_one();
+    });
+  }
+
+  body(0, count / parts);
+  std::unique_lock<std::mutex> lock(done_mutex);
+  done.wait(lock, [&] { return remaining == 0; });
+}
+
+std::unique_ptr<ThreadPool> createThreadPool(int threads) {
+  if (threads == 1) return nullptr;
+  return std::make_unique<ThreadPool>(threads > 1 ? threads - 1 : 0);
+}
+
+void ThreadPool::workerLoop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      job_available.wait(lock, [this] { return stopping || !jobs.empty(); });
+      if (stopping) return;
+      job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+    job();
+  }
+}
@@ -0,0 +1,46 @@
+/*
+Thread Pool - Fixed set of worker threads
+
+Runs submitted jobs in FIFO order on background threads. Jobs still queued when the pool is
+destroyed are dropped; running jobs are waited for.
+*/
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool class running jobs on worker threads
+class ThreadPool {
+  std::vector<std::thread> workers;         // worker threads
+  std::deque<std::function<void()>> jobs;   // jobs waiting for a worker
+  std::mutex mutex;                         // guards jobs and stopping
+  std::condition_variable job_available;    // signalled when a job is queued or on shutdown
+  bool stopping = false;                    // set once the pool is being destroyed
+
+  // Body of every worker thread
+  void workerLoop();
+
+ public:
+  // Start the workers; 0 uses one thread per hardware thread, minus one for the caller
+  explicit ThreadPool(int thread_count = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Queue a job to run on a worker
+  void submit(std::function<void()> job);
+  // Split [0, count) into one contiguous range per worker plus one for the calling thread,
+  // run body(begin, end) on every range and wait for all of them
+  void parallelFor(int count, const std::function<void(int begin, int end)>& body);
+  int getThreadCount() const { return static_cast<int>(workers.size()); }
+};
+
+// Create the pool of a command-line run on `threads` threads, the calling thread included:
+// nullptr for a single thread (the work runs serially), one per hardware thread for 0 or less
+std::unique_ptr<ThreadPool> createThreadPool(int threads);
@@ -1,14 +1,75 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <random>
+#include <vector>
+
 #include "camera3d/camera3d.hpp"
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/fixed-maze.hpp"
 #include "maze-generator/maze-generator.hpp"
+#include "maze-pack/maze-pack.hpp"
+#include "maze-renderer/maze-renderer.hpp"
+#include "maze-renderer/world-renderer.hpp"
+#include "maze-world/maze-world.hpp"
+#include "physics/simulation-thread.hpp"
 #include "player/player.hpp"
+#include "profiler/frame-profiler.hpp"
 #include "raylib.h"
+#include "telemetry/telemetry-recorder.hpp"
+#include "utils/asset-manager.hpp"
+#include "utils/conversions.hpp"
 #include "utils/helper.hpp"
+#include "utils/profiler-overlay.hpp"
 
-int main() {
+int main(int argc, char** argv) {
   const int SCREEN_WIDTH = 800;
   const int SCREEN_HEIGHT = 400;
   const int FPS = 60;
 
+  // maze size in cells, the screen size by default; larger mazes are panned and zoomed.
+  // --pack FILE --maze N opens a pre-generated maze instead of generating one.
+  int maze_cols = SCREEN_WIDTH / MazeRenderer::CELL_SIZE;
+  int maze_rows = SCREEN_HEIGHT / MazeRenderer::CELL_SIZE;
+  MazePack pack;
+  const char* pack_file = nullptr;
+  const char* pack_maze_text = "0";  // --maze as given, for the error message
+  long pack_maze = 0;
+  for (int i = 1; i + 1 < argc; ++i) {
+    int cols = 0;
+    int rows = 0;
+    if (std::strcmp(argv[i], "--size") == 0 &&
+        std::sscanf(argv[i + 1], "%dx%d", &cols, &rows) == 2 && cols > 1 && rows > 1 &&
+        cols <= UINT16_MAX && rows <= UINT16_MAX) {
+      maze_cols = cols;
+      maze_rows = rows;
+    } else if (std::strcmp(argv[i], "--pack") == 0) {
+      pack_file = argv[i + 1];
+      if (!pack.open(pack_file)) std::fprintf(stderr, "%s is not a maze pack\n", pack_file);
+    } else if (std::strcmp(argv[i], "--maze") == 0) {
+      char* end = nullptr;
+      pack_maze_text = argv[i + 1];
+      pack_maze = std::strtol(pack_maze_text, &end, 10);
+      if (end == pack_maze_text || *end != '\0') pack_maze = -1;
+    }
+  }
+  const bool from_pack = pack.isOpen();
+  if (from_pack && (pack_maze < 0 || pack_maze >= pack.getMazeCount())) {
+    std::fprintf(stderr, "Maze %s is not in %s, which holds %d mazes (numbered from 0)\n",
+                 pack_maze_text, pack_file, pack.getMazeCount());
+    return 1;
+  }
+  if (from_pack) {
+    maze_cols = pack.getEntry(pack_maze).cols;
+    maze_rows = pack.getEntry(pack_maze).rows;
+  }
+
   InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "NeuroPath");
 
   InitAudioDevice();  // Initialize audio device
@@ -17,15 +78,55 @@ int main() {
   DisableCursor();    // Disable cursor (lock cursor)
 
   // maze generator
-  MazeGenerator maze_generator(SCREEN_WIDTH, SCREEN_HEIGHT);
-
-  // player
+  MazeGenerator maze_generator(maze_cols, maze_rows);
+  maze_generator.setChangeTracking(true);  // the 2D view redraws only the tiles that changed
+  if (from_pack) {
+    // seed and algorithm too, so telemetry sessions in this maze can be replayed
+    const MazePackView maze = pack.getMaze(pack_maze);
+    maze_generator.setSeed(maze.entry->seed);
+    maze_generator.setAlgorithm(static_cast<GenerationAlgorithm>(maze.entry->algorithm));
+    maze_generator.load_walls(maze.walls);
+  }
+  pack.close();
+  MazeRenderer maze_renderer(maze_generator);
+  maze_renderer.resetView(SCREEN_WIDTH, SCREEN_HEIGHT);
+  const float PAN_SPEED = 400.0f;  // 2D view panning, in screen pixels per second
+  const float ZOOM_STEP = 1.25f;   // 2D zoom factor per wheel notch or key press
+
+  // endless maze, created when the endless mode starts; the render thread streams its chunks
+  // while the simulation thread queries their boxes
+  std::unique_ptr<MazeWorld> world;
+  std::mutex world_mutex;  // guards the resident chunks of the world
+  WorldRenderer world_renderer;
+
+  // floor and wall boxes around the player, from the endless world or the single maze; the
+  // player waits while the chunk below it is generated (simulation thread)
+  auto gatherBoxes = [&](const Vec3& position, const AABB& reach, std::vector<AABB>& floors,
+                         std::vector<AABB>& walls) {
+    auto addFloor = [&](const AABB& floor_bbox) {
+      floors.push_back(floor_bbox);
+      return false;
+    };
+    auto addWall = [&](const AABB& wall_bbox) {
+      walls.push_back(wall_bbox);
+      return false;
+    };
+    if (!world) {
+      maze_generator.getFloorIndex().forEachNear(reach, addFloor);
+      maze_generator.getWallIndex().forEachNear(reach, addWall);
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(world_mutex);
+    if (!world->findChunk(world->chunkAt(position))) return false;
+    world->forEachFloorNear(reach, addFloor);
+    world->forEachWallNear(reach, addWall);
+    return true;
+  };
+
+  // player, simulated at a fixed rate on its own thread once a 3D view starts, so slow frames
+  // delay neither its input nor its physics
   Player player({0.0f, 10.0f, 0.0f});
-  const float gravity = 9.81f;
-  const float jumpStrength = 5.0f;
   const float moveSpeed = 1.2f;
-  float jumpSpeed = 5.0f;
-  bool isJumping = false;
 
   // camera
   neuro_path::Camera3D camera({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
@@ -33,141 +134,264 @@ int main() {
   // animation frame control
   int frame_count = 0;
   int frame_interval = FPS / 2;
+  int steps_per_interval = 1;                  // generation steps applied every frame_interval
+  const int MAX_STEPS_PER_INTERVAL = 1 << 16;  // fastest animation speed
+  const double GENERATION_BUDGET = 0.004;      // seconds per frame spent applying generation
 
   bool render3d = false;
   bool showInfo = true;
-
-  // Load textures
-  Texture2D wallTexture = LoadTexture("resources/textures/wall_texture.jpg");
-  Texture2D floorTexture = LoadTexture("resources/textures/floor_texture.png");
+  bool showHints = false;  // distance and direction to the exit in the 3D view
+
+  // frame-phase profiler; records while its overlay is shown, or from the start when the
+  // NEUROPATH_PROFILE environment variable is set, and is dumped on exit
+  FrameProfiler profiler;
+  profiler.attachToThread();
+  profiler.setEnabled(std::getenv("NEUROPATH_PROFILE") != nullptr);
+  bool showProfiler = false;
+
+  // telemetry of the 3D session in the single maze, written off-thread and replayable with
+  // neuropath_telemetry
+  TelemetryRecorder telemetry;
+
+  SimulationThread simulation(helper::toVec3(player.getPos()), player.getDimensions(),
+                              gatherBoxes, &telemetry);
+  uint32_t jumps = 0;          // jump presses handed to the simulation
+  uint32_t heard_landings = 0;  // landings whose sound was played
+
+  // workers for the whole session: asset decoding, then the occlusion bake of the maze
+  ThreadPool worker_pool;
+
+  // Textures and sounds are decoded on workers and filled in once uploaded; the 3D view waits
+  // for them, the 2D maze does not need them
+  AssetManager assets(worker_pool);
+  const Texture2D& wallTexture =
+      assets.getTexture(assets.loadTextureAsync("resources/textures/wall_texture.jpg"));
+  const Texture2D& floorTexture =
+      assets.getTexture(assets.loadTextureAsync("resources/textures/floor_texture.png"));
 
   // Sound and Music effects
-  Sound walkSound = LoadSound("resources/sounds/walk.mp3");
-  Sound runSound = LoadSound("resources/sounds/running.mp3");
-  Sound jumpLandingSound = LoadSound("resources/sounds/jump_land.mp3");
-  Music bgMusic = LoadMusicStream("resources/sounds/bg.mp3");
+  const Sound& walkSound = assets.getSound(assets.loadSoundAsync("resources/sounds/walk.mp3"));
+  const Sound& runSound = assets.getSound(assets.loadSoundAsync("resources/sounds/running.mp3"));
+  const Sound& jumpLandingSound =
+      assets.getSound(assets.loadSoundAsync("resources/sounds/jump_land.mp3"));
+  Music bgMusic = LoadMusicStream("resources/sounds/bg.mp3");  // only opens the stream
 
   // Main game loop
   while (!WindowShouldClose()) {
-    float deltaTime = GetFrameTime();
-    UpdateMusicStream(bgMusic);
+    if (IsKeyPressed(KEY_F3)) {
+      showProfiler = !showProfiler;
+      if (showProfiler) profiler.setEnabled(true);
+    }
+    profiler.beginFrame();
 
-    if (render3d) {
-      if (!IsMusicStreamPlaying(bgMusic)) {
-        PlayMusicStream(bgMusic);
-      }
+    if (assets.isLoading()) assets.update();
+
+    {
+      PROFILE_PHASE(ProfilePhase::AUDIO);
       UpdateMusicStream(bgMusic);
-      camera.update();
-      const Vector3 cameraDirection = camera.getDirection();
+    }
 
-      // Update camera position and target
-      const float shake = sin(GetTime() * 10.0f) * 0.02f;
-      const Vector3 cameraOffset = {shake, 0.5f + shake,
-                                    shake};  // Camera height offset from player
-      camera.setPosition(Vector3Add(player.getPos(), cameraOffset));
-      camera.setTarget(Vector3Add(camera.getPosition(), cameraDirection));
+    // stream the chunks around the player; the player waits until the chunk below is generated
+    bool world_loading = false;
+    if (world) {
+      PROFILE_PHASE(ProfilePhase::WORLD);
+      const Vec3 player_position = helper::toVec3(player.getPos());
+      std::lock_guard<std::mutex> lock(world_mutex);
+      world->update(player_position);
+      world_loading = !world->findChunk(world->chunkAt(player_position));
+    }
 
-      // calculate forward and right vectors based on yaw
-      Vector3 forward = camera.getForward();
-      Vector3 right = camera.getRight();
-
-      // last player position
-      const Vector3 previousPlayerPosition = player.getPos();
-
-      // Player movement
-      if (IsKeyDown(KEY_LEFT_CONTROL)) {
-        const Vector3 newPos =
-            Vector3Add(player.getPos(), Vector3Scale(forward, (moveSpeed * 2) * deltaTime));
-        player.setPos(newPos);
-        helper::play_sound(runSound);
-      } else {
-        if (IsKeyDown(KEY_W)) {
-          const Vector3 newPos =
-              Vector3Add(player.getPos(), Vector3Scale(forward, moveSpeed * deltaTime));
-          player.setPos(newPos);
-          helper::play_sound(walkSound);
-        }
-        if (IsKeyDown(KEY_S)) {
-          const Vector3 newPos =
-              Vector3Subtract(player.getPos(), Vector3Scale(forward, moveSpeed * deltaTime));
-          player.setPos(newPos);
-          helper::play_sound(walkSound);
-        }
-        if (IsKeyDown(KEY_A)) {
-          const Vector3 newPos =
-              Vector3Add(player.getPos(), Vector3Scale(right, moveSpeed * deltaTime));
-          player.setPos(newPos);
-          helper::play_sound(walkSound);
+    if (render3d && !world_loading) {
+      {
+        PROFILE_PHASE(ProfilePhase::AUDIO);
+        if (!IsMusicStreamPlaying(bgMusic)) {
+          PlayMusicStream(bgMusic);
         }
-        if (IsKeyDown(KEY_D)) {
-          const Vector3 newPos =
-              Vector3Subtract(player.getPos(), Vector3Scale(right, moveSpeed * deltaTime));
-          player.setPos(newPos);
-          helper::play_sound(walkSound);
-        }
-      }
-
-      if (!IsKeyDown(KEY_LEFT_CONTROL) || isJumping) {
-        helper::stop_sound(runSound);
+        UpdateMusicStream(bgMusic);
       }
-      if ((!IsKeyDown(KEY_W) && !IsKeyDown(KEY_S) && !IsKeyDown(KEY_A) && !IsKeyDown(KEY_D)) ||
-          IsKeyDown(KEY_LEFT_CONTROL) || isJumping) {
-        helper::stop_sound(walkSound);
-      }
-
-      if (IsKeyPressed(KEY_SPACE) && !isJumping) {
-        jumpSpeed = jumpStrength;
-        isJumping = true;
+      {
+        PROFILE_PHASE(ProfilePhase::CAMERA);
+        camera.update();
       }
+      const Vector3 cameraDirection = camera.getDirection();
 
-      // Apply gravity if jumping
-      jumpSpeed -= gravity * deltaTime;
-      Vector3 newPos = Vector3Add(player.getPos(), {0.0f, jumpSpeed * deltaTime, 0.0f});
-      player.setPos(newPos);
+      const PlayerSnapshot snapshot = simulation.getSnapshot();
+      {
+        PROFILE_PHASE(ProfilePhase::INPUT);
+        // calculate forward and right vectors based on yaw
+        Vector3 forward = camera.getForward();
+        Vector3 right = camera.getRight();
+
+        const bool isJumping = !snapshot.grounded;
+
+        // Player movement: the input of this frame drives every simulation tick until the next
+        Vector3 walkVelocity = {0.0f, 0.0f, 0.0f};
+        if (IsKeyDown(KEY_LEFT_CONTROL)) {
+          walkVelocity = Vector3Scale(forward, moveSpeed * 2);
+          helper::play_sound(runSound);
+        } else {
+          if (IsKeyDown(KEY_W)) {
+            walkVelocity = Vector3Add(walkVelocity, Vector3Scale(forward, moveSpeed));
+            helper::play_sound(walkSound);
+          }
+          if (IsKeyDown(KEY_S)) {
+            walkVelocity = Vector3Subtract(walkVelocity, Vector3Scale(forward, moveSpeed));
+            helper::play_sound(walkSound);
+          }
+          if (IsKeyDown(KEY_A)) {
+            walkVelocity = Vector3Add(walkVelocity, Vector3Scale(right, moveSpeed));
+            helper::play_sound(walkSound);
+          }
+          if (IsKeyDown(KEY_D)) {
+            walkVelocity = Vector3Subtract(walkVelocity, Vector3Scale(right, moveSpeed));
+            helper::play_sound(walkSound);
+          }
+        }
 
-      const bool wasJumping = isJumping;
+        if (!IsKeyDown(KEY_LEFT_CONTROL) || isJumping) {
+          helper::stop_sound(runSound);
+        }
+        if ((!IsKeyDown(KEY_W) && !IsKeyDown(KEY_S) && !IsKeyDown(KEY_A) && !IsKeyDown(KEY_D)) ||
+            IsKeyDown(KEY_LEFT_CONTROL) || isJumping) {
+          helper::stop_sound(walkSound);
+        }
 
-      // Check for collision with the floor
-      for (const auto& floor_bbox : maze_generator.getFloorBBoxes()) {
-        if (CheckCollisionBoxes(player.getBBox(), floor_bbox)) {
-          Vector3 newPos = player.getPos();
-          newPos.y = floor_bbox.max.y;
-          player.setPos(newPos);
-          jumpSpeed = 0.0f;
-          isJumping = false;
-          break;
+        if (IsKeyPressed(KEY_H)) {
+          showHints = !showHints;
         }
+
+        // fixed-rate steps with swept collision run on the simulation thread: the player
+        // slides along walls and never tunnels through them
+        if (IsKeyPressed(KEY_SPACE)) jumps++;
+        SimulationInput input;
+        input.velocity = helper::toVec3(walkVelocity);
+        input.jumps = jumps;
+        input.yaw = camera.getYaw();
+        input.pitch = camera.getPitch();
+        input.keys = (IsKeyDown(KEY_W) ? KEY_BIT_FORWARD : 0) |
+                     (IsKeyDown(KEY_S) ? KEY_BIT_BACK : 0) | (IsKeyDown(KEY_A) ? KEY_BIT_LEFT : 0) |
+                     (IsKeyDown(KEY_D) ? KEY_BIT_RIGHT : 0) |
+                     (IsKeyDown(KEY_LEFT_CONTROL) ? KEY_BIT_RUN : 0) |
+                     (IsKeyDown(KEY_SPACE) ? KEY_BIT_JUMP : 0) | (showHints ? KEY_BIT_HINTS : 0);
+        simulation.setInput(input);
       }
 
-      if (wasJumping && !isJumping) {
+      if (snapshot.landings != heard_landings) {
+        heard_landings = snapshot.landings;
         helper::play_sound(jumpLandingSound);
       }
+      player.setPos(
+          helper::toVector3(simulation.getInterpolatedPosition(SimulationThread::Clock::now())));
 
-      // Check for collision with walls
-      for (const auto& wall_bbox : maze_generator.getWallBBoxes()) {
-        if (CheckCollisionBoxes(player.getBBox(), wall_bbox)) {
-          player.setPos(previousPlayerPosition);
-        }
-      }
-    } else {
+      // Update camera position and target
+      PROFILE_PHASE(ProfilePhase::CAMERA);
+      const float shake = sin(GetTime() * 10.0f) * 0.02f;
+      const Vector3 cameraOffset = {shake, 0.5f + shake,
+                                    shake};  // Camera height offset from player
+      camera.setPosition(Vector3Add(player.getPos(), cameraOffset));
+      camera.setTarget(Vector3Add(camera.getPosition(), cameraDirection));
+    } else if (!render3d) {
       frame_count++;
 
       if (IsKeyPressed(KEY_I)) {
         showInfo = !showInfo;
       }
+      if (IsKeyPressed(KEY_G)) {
+        // cycle through the generation algorithms (only before the generation starts)
+        const int next = (static_cast<int>(maze_generator.getAlgorithm()) + 1) %
+                         (static_cast<int>(GenerationAlgorithm::ELLER) + 1);
+        maze_generator.setAlgorithm(static_cast<GenerationAlgorithm>(next));
+      }
       if (IsKeyPressed(KEY_O)) {
-        maze_generator.start_generation();
+        maze_generator.start_async_generation();
         frame_count = 0;
       }
-      if (IsKeyPressed(KEY_P) && maze_generator.getState() == COMPLETED && !render3d) {
+      if (IsKeyPressed(KEY_P) && maze_generator.getState() == COMPLETED && !render3d &&
+          !assets.isLoading()) {
+        render3d = true;
+
+        // the physics has not run yet, so the session replays from the player's start
+        TelemetryHeader header;
+        header.maze_seed = maze_generator.getSeed();
+        header.algorithm = static_cast<uint8_t>(maze_generator.getAlgorithm());
+        header.cols = static_cast<uint16_t>(maze_generator.getGrid().getCols());
+        header.rows = static_cast<uint16_t>(maze_generator.getGrid().getRows());
+        header.start = simulation.getSnapshot().position;
+        header.player_width = player.getDimensions().width;
+        header.player_height = player.getDimensions().height;
+        header.player_depth = player.getDimensions().depth;
+        header.start_time = static_cast<int64_t>(std::time(nullptr));
+        const std::string file_name =
+            TextFormat("telemetry-%lld.nptl", static_cast<long long>(header.start_time));
+        if (!telemetry.start(file_name, header)) {
+          TraceLog(LOG_WARNING, "Failed to create %s", file_name.c_str());
+        }
+        simulation.start();
+      }
+      if (IsKeyPressed(KEY_E) && !render3d && !assets.isLoading()) {
+        world = std::make_unique<MazeWorld>(std::random_device{}());
         render3d = true;
+        simulation.start();
       }
+      if (IsKeyPressed(KEY_F)) {
+        // a standard maze not started yet is carved at once, without the heap
+        uint8_t fixed_walls[StandardMaze::PACKED_SIZE];
+        if (maze_generator.getState() == NOT_STARTED &&
+            generateFixedWalls(maze_generator.getGrid().getCols(),
+                               maze_generator.getGrid().getRows(), maze_generator.getAlgorithm(),
+                               maze_generator.getSeed(), fixed_walls)) {
+          maze_generator.load_walls(fixed_walls);
+        } else {
+          maze_generator.skip_generation();
+        }
+      }
+
+      // pan with WASD or the right mouse button, zoom around the screen center (the cursor is
+      // locked) with the wheel or +/-
+      const float pan = PAN_SPEED * GetFrameTime();
+      Vector2 pan_delta = {0.0f, 0.0f};
+      if (IsKeyDown(KEY_W)) pan_delta.y -= pan;
+      if (IsKeyDown(KEY_S)) pan_delta.y += pan;
+      if (IsKeyDown(KEY_A)) pan_delta.x -= pan;
+      if (IsKeyDown(KEY_D)) pan_delta.x += pan;
+      if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+        const Vector2 mouse_delta = GetMouseDelta();
+        pan_delta.x -= mouse_delta.x;
+        pan_delta.y -= mouse_delta.y;
+      }
+      maze_renderer.pan(pan_delta);
+      float zoom_notches = GetMouseWheelMove();
+      if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) zoom_notches += 1.0f;
+      if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) zoom_notches -= 1.0f;
+      if (zoom_notches != 0.0f) {
+        maze_renderer.zoomAt({SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f},
+                             std::pow(ZOOM_STEP, zoom_notches));
+      }
+      if (IsKeyPressed(KEY_Z)) {
+        maze_renderer.resetView(SCREEN_WIDTH, SCREEN_HEIGHT);
+      }
+      // speed up by shortening the interval first, then by applying more steps per interval
       if (IsKeyPressed(KEY_UP)) {
-        frame_interval = std::max(1, frame_interval - 1);
+        if (frame_interval > 1) {
+          frame_interval--;
+        } else {
+          steps_per_interval = std::min(MAX_STEPS_PER_INTERVAL, steps_per_interval * 2);
+        }
       }
       if (IsKeyPressed(KEY_DOWN)) {
-        frame_interval = std::min(FPS, frame_interval + 1);
+        if (steps_per_interval > 1) {
+          steps_per_interval /= 2;
+        } else {
+          frame_interval = std::min(FPS, frame_interval + 1);
+        }
+      }
+
+      // the worker generates ahead; apply its steps at the animation speed, within the budget
+      if (maze_generator.isGeneratingAsync()) {
+        const int steps = frame_count % frame_interval == 0 ? steps_per_interval : 0;
+        maze_generator.consumeEvents(steps, GENERATION_BUDGET);
       }
+      maze_generator.update(frame_count, frame_interval);
 
       // reset frame count
       if (frame_count % frame_interval == 0) {
@@ -175,18 +399,37 @@ int main() {
       }
     }
 
+    // the 3D meshes are built and baked as soon as the maze is complete, not by the first 3D
+    // frame
+    if (maze_generator.getState() == COMPLETED && !maze_renderer.isPrepared()) {
+      maze_renderer.prepare3D(&worker_pool);
+    }
+
     BeginDrawing();
     ClearBackground(RAYWHITE);
 
     if (!render3d) {
       // 2D rendering
-      maze_generator.draw(frame_count, frame_interval);
+      PROFILE_PHASE(ProfilePhase::DRAW_2D);
+      maze_renderer.draw();
 
       if (showInfo) {
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLUE, 0.8f));
         DrawText("Press O Key to start maze generation", 10, 10, 20, BLACK);
         DrawText("Press UP/DOWN Key to change maze generation speed", 10, 30, 20, BLACK);
-        DrawText("Press I Key to toggle this info", 10, 50, 20, BLACK);
+        DrawText("Press I Key to toggle this info, F Key to skip to the finished maze", 10, 50, 20,
+                 BLACK);
+        DrawText(TextFormat("Press G Key to change the algorithm: %s",
+                            getAlgorithmName(maze_generator.getAlgorithm())),
+                 10, 70, 20, BLACK);
+        DrawText("Press E Key to play the endless maze", 10, 90, 20, BLACK);
+        DrawText("WASD/right mouse to pan, wheel or +/- to zoom, Z to reset the view", 10, 110,
+                 20, BLACK);
+        if (assets.isLoading()) {
+          DrawText(TextFormat("Loading assets... %d%%",
+                              static_cast<int>(assets.getProgress() * 100.0f)),
+                   10, 130, 20, BLACK);
+        }
         if (maze_generator.getState() == IN_PROGRESS) {
           DrawText("Maze generation in progress...", 150, 170, 20, BLACK);
         } else if (maze_generator.getState() == COMPLETED) {
@@ -196,23 +439,70 @@ int main() {
       }
     } else {
       // 3D rendering
-      BeginMode3D(camera.getCamera());
-      // player.draw3D();
-      maze_generator.draw3D(false, wallTexture, floorTexture);
-      // DrawGrid(10, 1.0f);  // Draw a grid for reference
-      EndMode3D();
+      {
+        PROFILE_PHASE(ProfilePhase::DRAW_3D);
+        BeginMode3D(camera.getCamera());
+        // player.draw3D();
+        if (world) {
+          world_renderer.draw3D(*world, wallTexture, floorTexture, camera.getCamera());
+        } else {
+          maze_renderer.draw3D(false, wallTexture, floorTexture, camera.getCamera());
+        }
+        // DrawGrid(10, 1.0f);  // Draw a grid for reference
+        EndMode3D();
+      }
+
+      PROFILE_PHASE(ProfilePhase::DRAW_2D);
+      if (world_loading) {
+        DrawText("Generating the maze...", 10, 10, 20, BLACK);
+      }
+
+      // hint from the precomputed flow field: a lookup, no search
+      const int player_cell = world ? MazeGrid::NO_CELL
+                                    : maze_generator.getCellAt(helper::toVec3(player.getPos()));
+      if (showHints && player_cell != MazeGrid::NO_CELL) {
+        const char* const DIRECTION_NAMES[] = {"north", "east", "south", "west"};
+        const FlowField& flow_field = maze_generator.getFlowField();
+        const uint8_t direction = flow_field.getDirection(player_cell);
+        if (direction == FlowField::NO_DIRECTION) {
+          DrawText("You reached the exit!", 10, 10, 20, BLACK);
+        } else {
+          DrawText(TextFormat("Exit in %d cells, go %s", flow_field.getDistance(player_cell),
+                              DIRECTION_NAMES[direction]),
+                   10, 10, 20, BLACK);
+        }
+      }
+    }
+
+    if (showProfiler) {
+      neuro_path_profiler::DrawProfilerOverlay(profiler, SCREEN_WIDTH - 220, 10);
     }
 
-    EndDrawing();
+    {
+      PROFILE_PHASE(ProfilePhase::PRESENT);
+      EndDrawing();
+    }
+    profiler.endFrame();
   }
 
-  // cleanup
-  UnloadTexture(wallTexture);
-  UnloadTexture(floorTexture);
+  simulation.stop();
+  telemetry.stop();
+  if (telemetry.getDroppedSamples() > 0 || telemetry.hasFailed()) {
+    TraceLog(LOG_WARNING, "Telemetry incomplete: %llu frames dropped%s",
+             static_cast<unsigned long long>(telemetry.getDroppedSamples()),
+             telemetry.hasFailed() ? ", write failed" : "");
+  }
+
+  // dump the profile of the last frames
+  if (profiler.getRecordedFrames() > 0) {
+    if (!profiler.writeCsv("profile.csv")) TraceLog(LOG_WARNING, "Failed to write profile.csv");
+    if (!profiler.writeJson("profile.json")) TraceLog(LOG_WARNING, "Failed to write profile.json");
+  }
 
-  UnloadSound(walkSound);
-  UnloadSound(runSound);
-  UnloadSound(jumpLandingSound);
+  // cleanup
+  maze_renderer.unload();
+  world_renderer.unload();
+  assets.unload();
   UnloadMusicStream(bgMusic);
 
   CloseAudioDevice();
@@ -0,0 +1,39 @@
+#include "dfs-strategy.hpp"
+
+#include "utils/random.hpp"
+
+void DfsStrategy::start(MazeGrid& grid, std::mt19937&) {
+  current = 0;               // Start from the first cell
+  grid.setRoot(current);     // The first cell is the root of the parent tree
+  grid.setVisited(current);  // Mark the starting cell as visited
+}
+
+bool DfsStrategy::step(MazeGrid& grid, std::mt19937& rng) {
+  if (current == MazeGrid::NO_CELL) return false;
+
+  int candidates[4];  // directions leading to unvisited neighbors
+  int count = 0;
+
+  // Check all four possible directions (top, right, bottom, left)
+  for (int dir = TOP; dir <= LEFT; ++dir) {
+    const int neighbor = grid.getNeighbor(current, dir);
+    // Check if the neighbor is within bounds and has not been visited
+    if (neighbor != MazeGrid::NO_CELL && !grid.isVisited(neighbor)) {
+      candidates[count++] = dir;
+    }
+  }
+
+  // If there are unvisited neighbors, choose one randomly
+  if (count > 0) {
+    const int dir = candidates[helper::getRandomIndex(rng, count)];
+    const int next_cell = grid.getNeighbor(current, dir);
+    grid.setParentDirection(next_cell, oppositeDirection(dir));  // Set the parent of the next cell
+    grid.removeWall(current, dir);  // Remove the wall between current and next_cell
+    grid.setVisited(next_cell);     // Mark the next cell as visited
+    current = next_cell;            // Advance the search
+  } else {
+    // Backtrack if no unvisited neighbors; the parent codes double as the DFS stack
+    current = grid.getParent(current);
+  }
+  return true;
+}
@@ -0,0 +1,19 @@
+/*
+Recursive backtracker (depth-first search)
+
+Produces long winding corridors. The parent codes of the grid double as the DFS stack, so no extra
+memory is needed.
+*/
+#pragma once
+
+#include "generation-strategy.hpp"
+
+class DfsStrategy : public GenerationStrategy {
+  int current = MazeGrid::NO_CELL;  // cell at the head of the depth-first search
+
+ public:
+  void start(MazeGrid& grid, std::mt19937& rng) override;
+  bool step(MazeGrid& grid, std::mt19937& rng) override;
+  int getCurrentCell() const override { return current; }
+  bool buildsParentTree() const override { return true; }
+};
@@ -0,0 +1,86 @@
+#include "eller-strategy.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+int EllerStrategy::find(int id) {
+  while (set_parent[id] != id) {
+    set_parent[id] = set_parent[set_parent[id]];  // path halving
+    id = set_parent[id];
+  }
+  return id;
+}
+
+void EllerStrategy::start(MazeGrid& grid, std::mt19937&) {
+  const int cols = grid.getCols();
+  row = 0;
+  row_sets.assign(cols, -1);
+  set_parent.resize(cols);
+  members.resize(cols);
+  chosen.resize(cols);
+  remap.resize(cols);
+  roots.resize(cols);
+  current = MazeGrid::NO_CELL;
+}
+
+bool EllerStrategy::step(MazeGrid& grid, std::mt19937& rng) {
+  const int cols = grid.getCols();
+  const int rows = grid.getRows();
+  if (row >= rows) {
+    current = MazeGrid::NO_CELL;
+    return false;
+  }
+
+  // give the cells without a set a fresh id; ids stay below cols because a row has cols cells
+  int next_id = 0;
+  for (int x = 0; x < cols; ++x) next_id = std::max(next_id, row_sets[x] + 1);
+  for (int x = 0; x < cols; ++x) {
+    if (row_sets[x] < 0) row_sets[x] = next_id++;
+  }
+  std::iota(set_parent.begin(), set_parent.end(), 0);
+
+  // join neighbours in different sets at random (always on the last row)
+  const bool last_row = row == rows - 1;
+  for (int x = 0; x + 1 < cols; ++x) {
+    const int a = find(row_sets[x]);
+    const int b = find(row_sets[x + 1]);
+    if (a == b || (!last_row && (rng() & 1))) continue;
+
+    set_parent[b] = a;
+    grid.removeWall(grid.cellId(x, row), RIGHT);
+  }
+
+  for (int x = 0; x < cols; ++x) grid.setVisited(grid.cellId(x, row));
+  current = grid.cellId(0, row);
+
+  if (last_row) {
+    row++;
+    return true;
+  }
+
+  // carve down at random, making sure every set keeps at least one passage to the next row
+  std::fill(members.begin(), members.end(), 0);
+  for (int x = 0; x < cols; ++x) {
+    const int root = find(row_sets[x]);
+    roots[x] = root;
+    if (std::uniform_int_distribution<>(0, members[root])(rng) == 0) chosen[root] = x;
+    members[root]++;
+  }
+
+  std::fill(remap.begin(), remap.end(), -1);
+  int compact_id = 0;
+  for (int x = 0; x < cols; ++x) {
+    const int root = roots[x];
+    const bool down = (rng() & 1) || chosen[root] == x;
+    if (!down) {
+      row_sets[x] = -1;
+      continue;
+    }
+    grid.removeWall(grid.cellId(x, row), BOTTOM);
+    if (remap[root] < 0) remap[root] = compact_id++;
+    row_sets[x] = remap[root];
+  }
+
+  row++;
+  return true;
+}
@@ -0,0 +1,30 @@
+/*
+Eller's algorithm
+
+Builds the maze one row at a time, keeping only the set membership of the current row, so its
+working memory is O(width) no matter how many rows the maze has. Each step carves one row.
+*/
+#pragma once
+
+#include <vector>
+
+#include "generation-strategy.hpp"
+
+class EllerStrategy : public GenerationStrategy {
+  int row = 0;                       // next row to carve
+  std::vector<int> row_sets;         // set id of every cell in the current row (-1: none yet)
+  std::vector<int> set_parent;       // union-find parent of every set id
+  std::vector<int> members;          // cells of each set seen so far in the row
+  std::vector<int> chosen;           // cell of each set picked to carve down (reservoir sample)
+  std::vector<int> roots;            // representative set of every cell in the current row
+  std::vector<int> remap;            // set id of each representative in the next row
+  int current = MazeGrid::NO_CELL;   // first cell of the last carved row
+
+  // Find the representative of a set id
+  int find(int id);
+
+ public:
+  void start(MazeGrid& grid, std::mt19937& rng) override;
+  bool step(MazeGrid& grid, std::mt19937& rng) override;
+  int getCurrentCell() const override { return current; }
+};
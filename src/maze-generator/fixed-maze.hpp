@@ -0,0 +1,154 @@
+/*
+Fixed Maze - Maze generation and solving specialized for a size known at compile time
+
+For the standard assessment sizes the grid dimensions are template parameters: cells live in a
+std::array (walls, visited flag and parent code in one byte each), neighbour offsets are
+constants and the border of every cell is a precomputed mask, so generating and solving never
+allocate and the compiler sees every loop bound. Generation is the recursive backtracker and
+carves the same maze as MazeGenerator with DFS and the same seed; packWalls() hands the result
+to MazeGenerator::load_walls() or a maze pack. generateFixedWalls() picks this path for the
+standard 40x20 size (the game's default maze and packs); other sizes use the dynamic MazeGrid.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "generation-strategy.hpp"
+#include "maze-grid.hpp"
+
+// FixedMaze class holding and solving a Cols x Rows maze without heap storage
+template <int Cols, int Rows>
+class FixedMaze {
+ public:
+  static constexpr int COLS = Cols;
+  static constexpr int ROWS = Rows;
+  static constexpr int CELLS = Cols * Rows;
+  static constexpr int PACKED_SIZE = (CELLS + 1) / 2;  // bytes written by packWalls()
+  static_assert(Cols > 0 && Rows > 0 && CELLS > 1, "a maze needs at least two cells");
+  static_assert(CELLS <= 1 << 16, "cell ids are stored in 16 bits");
+
+ private:
+  static constexpr uint8_t VISITED = 0x10;  // cell byte: bits 0-3 walls, bit 4 visited,
+  static constexpr int PARENT_SHIFT = 5;    // bits 5-6 direction code to the parent
+  static constexpr uint8_t UNREACHED = 0xFF;             // solver: cell not reached yet
+  static constexpr int OFFSETS[4] = {-Cols, 1, Cols, -1};  // neighbour id offset by direction
+
+  // Directions leaving the grid from every cell, as wall bits
+  static constexpr std::array<uint8_t, CELLS> makeBorders() {
+    std::array<uint8_t, CELLS> masks{};
+    for (int cell = 0; cell < CELLS; ++cell) {
+      const int x = cell % Cols;
+      const int y = cell / Cols;
+      masks[cell] = static_cast<uint8_t>((y == 0 ? wallBit(TOP) : 0) |
+                                         (x == Cols - 1 ? wallBit(RIGHT) : 0) |
+                                         (y == Rows - 1 ? wallBit(BOTTOM) : 0) |
+                                         (x == 0 ? wallBit(LEFT) : 0));
+    }
+    return masks;
+  }
+  static constexpr std::array<uint8_t, CELLS> BORDERS = makeBorders();
+
+  std::array<uint8_t, CELLS> cells;     // walls, visited flag and parent code of every cell
+  std::array<uint8_t, CELLS> from_dir;  // solver: direction back towards the start
+  std::array<uint16_t, CELLS> queue;    // solver: BFS queue
+
+ public:
+  FixedMaze() { cells.fill(MazeGrid::ALL_WALLS); }
+
+  uint8_t getWalls(int cell) const { return cells[cell] & MazeGrid::ALL_WALLS; }
+  bool hasWall(int cell, int dir) const { return (cells[cell] & wallBit(dir)) != 0; }
+  // Parent of a cell in the tree carved by generate(), NO_CELL for the first cell
+  int getParent(int cell) const {
+    return cell == 0 ? MazeGrid::NO_CELL : cell + OFFSETS[(cells[cell] >> PARENT_SHIFT) & 3];
+  }
+
+  // Carve a new maze with the recursive backtracker, exactly as DfsStrategy does
+  void generate(uint32_t seed) {
+    std::mt19937 rng(seed);
+    cells.fill(MazeGrid::ALL_WALLS);
+    int current = 0;
+    cells[current] |= VISITED;
+
+    // the parent codes double as the DFS stack
+    while (current != MazeGrid::NO_CELL) {
+      int candidates[4];
+      int count = 0;
+      const uint8_t border = BORDERS[current];
+      for (int dir = TOP; dir <= LEFT; ++dir) {
+        if (!(border & wallBit(dir)) && !(cells[current + OFFSETS[dir]] & VISITED)) {
+          candidates[count++] = dir;
+        }
+      }
+      if (count == 0) {
+        current = getParent(current);
+        continue;
+      }
+
+      std::uniform_int_distribution<> distrib(0, count - 1);
+      const int dir = candidates[distrib(rng)];
+      const int next = current + OFFSETS[dir];
+      cells[current] &= static_cast<uint8_t>(~wallBit(dir));
+      cells[next] = static_cast<uint8_t>((cells[next] & ~wallBit(oppositeDirection(dir))) |
+                                         VISITED | (oppositeDirection(dir) << PARENT_SHIFT));
+      current = next;
+    }
+  }
+
+  // Find the shortest path from start to goal (both included) with a breadth-first search;
+  // returns the number of cells written to path, 0 if the goal cannot be reached
+  int solve(int start, int goal, std::array<int, CELLS>& path) {
+    from_dir.fill(UNREACHED);
+    from_dir[start] = 0;
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = static_cast<uint16_t>(start);
+    while (head < tail && from_dir[goal] == UNREACHED) {
+      const int cell = queue[head++];
+      const uint8_t closed = cells[cell];  // border walls are always standing
+      for (int dir = TOP; dir <= LEFT; ++dir) {
+        if (closed & wallBit(dir)) continue;
+        const int next = cell + OFFSETS[dir];
+        if (from_dir[next] != UNREACHED) continue;
+        from_dir[next] = static_cast<uint8_t>(oppositeDirection(dir));
+        queue[tail++] = static_cast<uint16_t>(next);
+      }
+    }
+    if (from_dir[goal] == UNREACHED) return 0;
+
+    int length = 0;
+    for (int cell = goal; cell != start; cell += OFFSETS[from_dir[cell]]) path[length++] = cell;
+    path[length++] = start;
+    for (int i = 0, j = length - 1; i < j; ++i, --j) std::swap(path[i], path[j]);
+    return length;
+  }
+
+  // Write the walls packed byte for byte like a row-major MazeGrid (see MazeGrid::packWalls)
+  void packWalls(uint8_t* out) const {
+    for (int cell = 0; cell + 1 < CELLS; cell += 2) {
+      out[cell >> 1] = static_cast<uint8_t>(getWalls(cell) | (getWalls(cell + 1) << 4));
+    }
+    // the unused half of an odd last byte keeps its walls, as in MazeGrid
+    if (CELLS & 1) out[CELLS >> 1] = static_cast<uint8_t>(getWalls(CELLS - 1) | 0xF0);
+  }
+};
+
+// Standard assessment size, also the default maze of the game
+using StandardMaze = FixedMaze<40, 20>;
+
+// Carve the maze of a seed with FixedMaze and write its walls packed like MazeGrid::packWalls()
+// when the size and algorithm have a specialization (DFS at the standard size); returns false,
+// writing nothing, for any other maze
+inline bool generateFixedWalls(int cols, int rows, GenerationAlgorithm algorithm, uint32_t seed,
+                               uint8_t* packed_walls) {
+  if (algorithm != GenerationAlgorithm::DFS || cols != StandardMaze::COLS ||
+      rows != StandardMaze::ROWS) {
+    return false;
+  }
+  StandardMaze maze;
+  maze.generate(seed);
+  maze.packWalls(packed_walls);
+  return true;
+}
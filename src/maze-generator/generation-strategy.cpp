@@ -0,0 +1,68 @@
+#include "generation-strategy.hpp"
+
+#include <cctype>
+
+#include "dfs-strategy.hpp"
+#include "eller-strategy.hpp"
+#include "kruskal-strategy.hpp"
+#include "prim-strategy.hpp"
+#include "wilson-strategy.hpp"
+
+std::unique_ptr<GenerationStrategy> createGenerationStrategy(GenerationAlgorithm algorithm) {
+  switch (algorithm) {
+    case GenerationAlgorithm::KRUSKAL:
+      return std::make_unique<KruskalStrategy>();
+    case GenerationAlgorithm::PRIM:
+      return std::make_unique<PrimStrategy>();
+    case GenerationAlgorithm::WILSON:
+      return std::make_unique<WilsonStrategy>();
+    case GenerationAlgorithm::ELLER:
+      return std::make_unique<EllerStrategy>();
+    default:
+      return std::make_unique<DfsStrategy>();
+  }
+}
+
+void generateSeededMaze(MazeGrid& grid, GenerationAlgorithm algorithm, uint32_t seed) {
+  // the same rng use as MazeGenerator::setSeed() followed by finish_generation()
+  std::mt19937 rng(seed);
+  std::unique_ptr<GenerationStrategy> strategy = createGenerationStrategy(algorithm);
+  strategy->start(grid, rng);
+  while (strategy->step(grid, rng)) {
+  }
+}
+
+const char* getAlgorithmName(GenerationAlgorithm algorithm) {
+  switch (algorithm) {
+    case GenerationAlgorithm::KRUSKAL:
+      return "Kruskal";
+    case GenerationAlgorithm::PRIM:
+      return "Prim";
+    case GenerationAlgorithm::WILSON:
+      return "Wilson";
+    case GenerationAlgorithm::ELLER:
+      return "Eller";
+    default:
+      return "DFS";
+  }
+}
+
+bool parseAlgorithmName(const char* name, GenerationAlgorithm& algorithm) {
+  for (const GenerationAlgorithm candidate :
+       {GenerationAlgorithm::DFS, GenerationAlgorithm::KRUSKAL, GenerationAlgorithm::PRIM,
+        GenerationAlgorithm::WILSON, GenerationAlgorithm::ELLER}) {
+    const char* a = name;
+    const char* b = getAlgorithmName(candidate);
+    while (*a && *b &&
+           std::tolower(static_cast<unsigned char>(*a)) ==
+               std::tolower(static_cast<unsigned char>(*b))) {
+      ++a;
+      ++b;
+    }
+    if (*a == '\0' && *b == '\0') {
+      algorithm = candidate;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,43 @@
+/*
+Generation Strategy - Pluggable maze generation algorithms
+
+Every algorithm carves a perfect maze (a spanning tree of the cells) into a MazeGrid one step at a
+time, so the 2D view can animate any of them.
+*/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "maze-grid.hpp"
+
+// Maze generation algorithms
+enum class GenerationAlgorithm { DFS, KRUSKAL, PRIM, WILSON, ELLER };
+
+// Interface of a step-wise maze generation algorithm
+class GenerationStrategy {
+ public:
+  virtual ~GenerationStrategy() = default;
+
+  // Prepare a new maze on a grid with all walls standing
+  virtual void start(MazeGrid& grid, std::mt19937& rng) = 0;
+  // Carve the next piece of the maze; returns false once the maze is complete
+  virtual bool step(MazeGrid& grid, std::mt19937& rng) = 0;
+  // Cell to highlight in the animation, NO_CELL if there is none
+  virtual int getCurrentCell() const = 0;
+  // Whether the grid's parent codes form the spanning tree when generation completes
+  virtual bool buildsParentTree() const { return false; }
+};
+
+// Create the strategy for an algorithm
+std::unique_ptr<GenerationStrategy> createGenerationStrategy(GenerationAlgorithm algorithm);
+
+// Carve the maze a MazeGenerator would carve with the same size, algorithm and seed into a grid
+// with all walls standing (walls only: no parent tree, no border openings)
+void generateSeededMaze(MazeGrid& grid, GenerationAlgorithm algorithm, uint32_t seed);
+
+// Get the display name of an algorithm
+const char* getAlgorithmName(GenerationAlgorithm algorithm);
+// Find the algorithm with a display name, ignoring case; false if there is none
+bool parseAlgorithmName(const char* name, GenerationAlgorithm& algorithm);
@@ -0,0 +1,80 @@
+#include "kruskal-strategy.hpp"
+
+#include <numeric>
+
+int KruskalStrategy::find(int cell) {
+  while (sets[cell] != cell) {
+    sets[cell] = sets[sets[cell]];  // path halving
+    cell = sets[cell];
+  }
+  return cell;
+}
+
+uint64_t KruskalStrategy::permute(uint64_t index) const {
+  const uint64_t mask = (uint64_t{1} << half_bits) - 1;
+  uint64_t left = index >> half_bits;
+  uint64_t right = index & mask;
+  for (const uint32_t key : keys) {
+    uint32_t hash = static_cast<uint32_t>(right) ^ key;
+    hash *= 0x9E3779B1u;
+    hash ^= hash >> 15;
+    hash *= 0x85EBCA77u;
+    hash ^= hash >> 13;
+    const uint64_t next = left ^ (hash & mask);
+    left = right;
+    right = next;
+  }
+  return (left << half_bits) | right;
+}
+
+void KruskalStrategy::start(MazeGrid& grid, std::mt19937& rng) {
+  const int cols = grid.getCols();
+  const int rows = grid.getRows();
+  sets.resize(grid.getCellCount());
+  std::iota(sets.begin(), sets.end(), 0);
+
+  // walls to the right of a cell come first, then walls below a cell
+  edge_count = static_cast<uint64_t>(cols - 1) * rows + static_cast<uint64_t>(cols) * (rows - 1);
+  half_bits = 1;
+  while ((uint64_t{1} << (2 * half_bits)) < edge_count) half_bits++;
+  domain = uint64_t{1} << (2 * half_bits);
+  for (uint32_t& key : keys) key = rng();
+  counter = 0;
+  current = MazeGrid::NO_CELL;
+}
+
+bool KruskalStrategy::step(MazeGrid& grid, std::mt19937&) {
+  const int cols = grid.getCols();
+  const uint64_t horizontal_edges = static_cast<uint64_t>(cols - 1) * grid.getRows();
+
+  // skip walls whose cells are already connected, so every step removes a wall
+  while (counter < domain) {
+    const uint64_t edge = permute(counter++);
+    if (edge >= edge_count) continue;
+
+    int cell;
+    int dir;
+    if (edge < horizontal_edges) {
+      cell = static_cast<int>(edge / (cols - 1)) * cols + static_cast<int>(edge % (cols - 1));
+      dir = RIGHT;
+    } else {
+      cell = static_cast<int>(edge - horizontal_edges);
+      dir = BOTTOM;
+    }
+    const int neighbor = grid.getNeighbor(cell, dir);
+
+    const int a = find(cell);
+    const int b = find(neighbor);
+    if (a == b) continue;
+
+    sets[a] = b;
+    grid.removeWall(cell, dir);
+    grid.setVisited(cell);
+    grid.setVisited(neighbor);
+    current = neighbor;
+    return true;
+  }
+
+  current = MazeGrid::NO_CELL;
+  return false;
+}
@@ -0,0 +1,33 @@
+/*
+Randomized Kruskal's algorithm
+
+Visits every interior wall once in random order and removes it when the cells on both sides are
+not connected yet (union-find). Produces many short dead ends. The random order comes from a
+Feistel permutation of the wall indices, so no shuffled wall list is stored.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "generation-strategy.hpp"
+
+class KruskalStrategy : public GenerationStrategy {
+  std::vector<int> sets;               // union-find parent of every cell
+  uint64_t counter = 0;                // position in the permuted wall order
+  uint64_t domain = 0;                 // size of the permutation domain (power of four)
+  uint64_t edge_count = 0;             // number of interior walls
+  int half_bits = 0;                   // bits of each Feistel half
+  uint32_t keys[4] = {0, 0, 0, 0};     // Feistel round keys
+  int current = MazeGrid::NO_CELL;     // cell of the last removed wall
+
+  // Find the representative of a cell's set
+  int find(int cell);
+  // Map a counter value to a wall index
+  uint64_t permute(uint64_t index) const;
+
+ public:
+  void start(MazeGrid& grid, std::mt19937& rng) override;
+  bool step(MazeGrid& grid, std::mt19937& rng) override;
+  int getCurrentCell() const override { return current; }
+};
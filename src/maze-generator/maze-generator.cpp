@@ -1,13 +1,91 @@
 #include "maze-generator.hpp"
 
-MazeGenerator::MazeGenerator(const int& width, const int& height)
-    : WIDTH(width), HEIGHT(height), COLS(width / CELL_SIZE), ROWS(height / CELL_SIZE) {
-  // Initialize the grid with Node pointers
-  for (int i = 0; i < ROWS; ++i) {
-    for (int j = 0; j < COLS; ++j) {
-      grid.push_back(std::make_unique<Node>(j, i));
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "profiler/frame-profiler.hpp"
+#include "tiled-generation.hpp"
+
+MazeGenerator::MazeGenerator(const int& cols, const int& rows, CellOrder order)
+    : grid(cols, rows, order), seed(std::random_device{}()), rng(seed) {}
+
+MazeGenerator::~MazeGenerator() {
+  if (worker.joinable()) {
+    cancel_requested = true;
+    worker.join();
+  }
+}
+
+int MazeGenerator::getCellAt(const Vec3& position) const {
+  // cell (0, 0) is centered on the origin
+  const int x = static_cast<int>(std::floor(position.x / floor_dimension.width + 0.5f));
+  const int y = static_cast<int>(std::floor(position.z / floor_dimension.depth + 0.5f));
+  if (x < 0 || x >= grid.getCols() || y < 0 || y >= grid.getRows()) return MazeGrid::NO_CELL;
+  return grid.cellId(x, y);
+}
+
+int MazeGenerator::getCurrentCell() const {
+  if (state != IN_PROGRESS) return MazeGrid::NO_CELL;
+  // the strategy belongs to the worker while it runs
+  return worker.joinable() ? event_current : strategy->getCurrentCell();
+}
+
+void MazeGenerator::setAlgorithm(GenerationAlgorithm new_algorithm) {
+  if (state != NOT_STARTED) return;
+  algorithm = new_algorithm;
+}
+
+void MazeGenerator::setSeed(uint32_t new_seed) {
+  if (state != NOT_STARTED) return;
+  seed = new_seed;
+  rng.seed(seed);
+}
+
+void MazeGenerator::setChangeTracking(bool enable) {
+  if (state != NOT_STARTED) return;
+  tracking_changes = enable;
+  grid.setChangeLog(enable ? &grid_changes : nullptr);
+  const int regions_x = (grid.getCols() + REGION_SIZE - 1) / REGION_SIZE;
+  const int regions_y = (grid.getRows() + REGION_SIZE - 1) / REGION_SIZE;
+  region_revisions.assign(enable ? static_cast<std::size_t>(regions_x) * regions_y : 0, 0);
+}
+
+uint32_t MazeGenerator::getRegionRevision(int region_x, int region_y) const {
+  if (region_revisions.empty()) return revision;
+  const int regions_x = (grid.getCols() + REGION_SIZE - 1) / REGION_SIZE;
+  return std::max(full_revision, region_revisions[region_y * regions_x + region_x]);
+}
+
+void MazeGenerator::stampChanges() {
+  if (grid_changes.empty()) return;
+
+  const uint32_t stamp = ++revision;
+  const int regions_x = (grid.getCols() + REGION_SIZE - 1) / REGION_SIZE;
+  auto stampCell = [&](int cell) {
+    region_revisions[(grid.cellY(cell) / REGION_SIZE) * regions_x +
+                     grid.cellX(cell) / REGION_SIZE] = stamp;
+  };
+  for (const GridChange& change : grid_changes) {
+    stampCell(change.cell);
+    // a removed wall is also drawn as part of the neighbour, which may be in another region
+    if (change.dir != VISIT_CHANGE) {
+      const int neighbor = grid.getNeighbor(change.cell, change.dir);
+      if (neighbor != MazeGrid::NO_CELL) stampCell(neighbor);
     }
   }
+  grid_changes.clear();
+}
+
+void MazeGenerator::addBorderOpening(int cell, int dir) {
+  if (state != NOT_STARTED) return;
+  border_openings.emplace_back(cell, dir);
+}
+
+void MazeGenerator::setSharedBorders(bool shared) {
+  if (state != NOT_STARTED) return;
+  shared_borders = shared;
 }
 
 void MazeGenerator::start_generation() {
@@ -15,267 +93,282 @@ void MazeGenerator::start_generation() {
 
   state = IN_PROGRESS;  // Set the state to in progress
 
-  Node* start_node = grid[0].get();  // Start from the first node
-  stack.push(start_node);            // Start from the first node
-  start_node->visited = true;        // Mark the starting node as visited
+  strategy = createGenerationStrategy(algorithm);
+  strategy->start(grid, rng);
+  stampAll();
 
-  generate();  // Start the depth-first search to generate the maze
+  generate();  // Carve the first step of the maze
 }
 
-void MazeGenerator::generate() {
-  if (state != IN_PROGRESS) return;
+void MazeGenerator::start_async_generation() {
+  if (state != NOT_STARTED) return;
 
-  if (stack.empty()) {
-    state = COMPLETED;
-    calcPath();
-    calcBoundingBoxes();
-    return;
-  }
+  state = IN_PROGRESS;
 
-  Node* current = stack.top();   // get the current node from the stack
-  std::vector<Node*> neighbors;  // vector to hold unvisited neighbors
+  worker_grid = std::make_unique<MazeGrid>(grid.getCols(), grid.getRows(), grid.getOrder());
+  events = std::make_unique<SpscQueue<GenerationEvent>>(EVENT_QUEUE_CAPACITY);
+  strategy = createGenerationStrategy(algorithm);
+  stampAll();
+  worker = std::thread(&MazeGenerator::runWorker, this);
+}
 
-  // Check all four possible directions (top, right, bottom, left)
-  for (auto& direction : directions) {
-    int nx = current->x + direction.first;   // x-coordinate of the neighbor
-    int ny = current->y + direction.second;  // y-coordinate of the neighbor
+void MazeGenerator::skip_generation() { skip_requested = true; }
 
-    // Check if the neighbor is within bounds
-    if (nx >= 0 && nx < COLS && ny >= 0 && ny < ROWS) {
-      Node* neighbor = grid[ny * COLS + nx].get();  // get the neighbor node (2D to 1D index)
-      // Check if the neighbor has not been visited
-      if (!neighbor->visited) {
-        neighbors.push_back(neighbor);
-      }
+void MazeGenerator::finish_generation() {
+  start_generation();
+  if (worker.joinable()) skip_generation();
+  while (state == IN_PROGRESS) {
+    if (worker.joinable()) {
+      consumeEvents(0, 0.0);
+      std::this_thread::yield();
+    } else {
+      generate();
     }
   }
+}
 
-  // If there are unvisited neighbors, choose one randomly
-  if (!neighbors.empty()) {
-    Node* next_node = helper::getRandomElement(neighbors).value();
-    next_node->parent = current;     // Set the parent of the next node
-    removeWall(current, next_node);  // Remove the wall between current and next_node
-    next_node->visited = true;       // Mark the next node as visited
-    stack.push(next_node);           // Push the next node onto the stack
+void MazeGenerator::tiled_generation(ThreadPool& thread_pool) {
+  if (state != NOT_STARTED) return;
+  state = IN_PROGRESS;
+
+  // the tiles are carved concurrently, so the changes cannot be logged as they happen
+  grid.setChangeLog(nullptr);
+  generateTiledMaze(grid, algorithm, seed, &thread_pool);
+  if (tracking_changes) grid.setChangeLog(&grid_changes);
+
+  completeGrid(grid);  // no strategy: the parent tree is built from the carved walls
+  completeGeneration();
+}
+
+void MazeGenerator::load_walls(const uint8_t* packed_walls) {
+  if (state != NOT_STARTED) return;
+  state = IN_PROGRESS;
+  grid.unpackWalls(packed_walls);
+  completeGrid(grid);
+  completeGeneration();
+}
+
+void MazeGenerator::generate() {
+  if (state != IN_PROGRESS || worker.joinable()) return;
+  const bool carving = strategy->step(grid, rng);
+  if (tracking_changes) {
+    stampChanges();
   } else {
-    stack.pop();  // Backtrack if no unvisited neighbors
+    stampAll();
   }
+  if (carving) return;
+
+  completeGrid(grid);
+  completeGeneration();
 }
 
-void MazeGenerator::removeWall(Node* a, Node* b) {
-  int dx = b->x - a->x;
-  int dy = b->y - a->y;
+void MazeGenerator::completeGrid(MazeGrid& target) {
+  // The parent tree roots the path at the first cell; only DFS builds it while carving
+  if (!strategy || !strategy->buildsParentTree()) target.buildParentTree(0);
+  for (const auto& [cell, dir] : border_openings) target.removeWall(cell, dir);
+}
 
-  if (dx == 1) {          // b is to the right of a
-    a->walls[1] = false;  // right wall
-    b->walls[3] = false;  // left wall
-  } else if (dx == -1) {  // b is to the left of a
-    a->walls[3] = false;  // left wall
-    b->walls[1] = false;  // right wall
+void MazeGenerator::completeGeneration() {
+  strategy.reset();
+  state = COMPLETED;
+  grid_changes.clear();
+  stampAll();
+  {
+    PROFILE_PHASE(ProfilePhase::MAZE_PATH);
+    calcPath();
   }
-  if (dy == 1) {          // b is below a
-    a->walls[2] = false;  // bottom wall
-    b->walls[0] = false;  // top wall
-  } else if (dy == -1) {  // b is above a
-    a->walls[0] = false;  // top wall
-    b->walls[2] = false;  // bottom wall
+  {
+    PROFILE_PHASE(ProfilePhase::MAZE_FLOW_FIELD);
+    flow_field.build(grid, grid.getCellCount() - 1);
   }
+  PROFILE_PHASE(ProfilePhase::MAZE_BOUNDS);
+  calcBoundingBoxes();
 }
 
-void MazeGenerator::calcPath() {
-  Node* current = grid[grid.size() - 1].get();  // Start from the end node (bottom-right corner)
+bool MazeGenerator::publish(const GenerationEvent& event) {
+  while (!events->tryPush(event)) {
+    if (skip_requested || cancel_requested) return false;
+    // the animation is behind; wait for it without spinning a core
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
 
-  while (current) {
-    path.push_back(current);
-    current = current->parent;
+void MazeGenerator::runWorker() {
+  std::vector<GridChange> changes;
+  worker_grid->setChangeLog(&changes);
+  strategy->start(*worker_grid, rng);
+
+  bool carving = true;
+  while (carving && !cancel_requested) {
+    carving = strategy->step(*worker_grid, rng);
+
+    // once skipping, only the finished grid matters
+    if (!skip_requested) {
+      for (const GridChange& change : changes) {
+        const GenerationEvent event =
+            change.dir == VISIT_CHANGE
+                ? GenerationEvent{change.cell, GenerationEventType::VISIT, 0}
+                : GenerationEvent{change.cell, GenerationEventType::CARVE,
+                                  static_cast<uint8_t>(change.dir)};
+        if (!publish(event)) break;
+      }
+      publish({strategy->getCurrentCell(), GenerationEventType::STEP, 0});
+    }
+    changes.clear();
   }
+  worker_grid->setChangeLog(nullptr);
 
-  std::reverse(path.begin(), path.end());  // Reverse the path to go from start to end
+  if (!cancel_requested) completeGrid(*worker_grid);
+  worker_done.store(true, std::memory_order_release);
 }
 
-void MazeGenerator::draw(const int& frame_count, const int& fps) {
-  // Draw the maze grid
-  for (const auto& cell : grid) {
-    int x = cell->x * CELL_SIZE;
-    int y = cell->y * CELL_SIZE;
-
-    if (state == IN_PROGRESS && cell->visited) {
-      DrawRectangle(x, y, CELL_SIZE, CELL_SIZE, Fade(LIGHTGRAY, 0.5f));
+int MazeGenerator::consumeEvents(int max_steps, double budget_seconds) {
+  if (state != IN_PROGRESS || !worker.joinable()) return 0;
+  PROFILE_PHASE(ProfilePhase::GENERATION);
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double>(budget_seconds));
+  // when skipping, the events are dropped (the finished grid replaces them) but still drained
+  // so the worker is never stuck on a full queue
+  const bool skipping = skip_requested;
+
+  int applied = 0;
+  int steps = 0;
+  GenerationEvent event;
+  while ((skipping || steps < max_steps) && events->tryPop(event)) {
+    if (!skipping) {
+      switch (event.type) {
+        case GenerationEventType::CARVE:
+          grid.removeWall(event.cell, event.dir);
+          break;
+        case GenerationEventType::VISIT:
+          grid.setVisited(event.cell);
+          break;
+        case GenerationEventType::STEP:
+          event_current = event.cell;
+          steps++;
+          break;
+      }
     }
+    // reading the clock is far slower than applying an event
+    if ((++applied & 63) == 0 && Clock::now() >= deadline) break;
+  }
 
-    // Draw walls based on the wall flags
-    if (cell->walls[0]) {  // Top wall
-      DrawLine(x, y, x + CELL_SIZE, y, BLACK);
-    }
-    if (cell->walls[1]) {  // Right wall
-      DrawLine(x + CELL_SIZE, y, x + CELL_SIZE, y + CELL_SIZE, BLACK);
-    }
-    if (cell->walls[2]) {  // Bottom wall
-      DrawLine(x, y + CELL_SIZE, x + CELL_SIZE, y + CELL_SIZE, BLACK);
-    }
-    if (cell->walls[3]) {  // Left wall
-      DrawLine(x, y, x, y + CELL_SIZE, BLACK);
-    }
+  if (tracking_changes) {
+    stampChanges();
+  } else if (applied > 0) {
+    stampAll();
+  }
+
+  // worker_done first: its release makes every event pushed before it visible to empty()
+  if (worker_done.load(std::memory_order_acquire) && events->empty()) {
+    worker.join();
+    grid = std::move(*worker_grid);
+    worker_grid.reset();
+    events.reset();
+    event_current = MazeGrid::NO_CELL;
+    completeGeneration();
   }
+  return applied;
+}
+
+void MazeGenerator::calcPath() {
+  path.clear();
+  int cell = grid.getCellCount() - 1;  // Start from the end cell (bottom-right corner)
+
+  while (cell != MazeGrid::NO_CELL) {
+    path.push_back(cell);
+    cell = grid.getParent(cell);
+  }
+
+  std::reverse(path.begin(), path.end());  // Reverse the path to go from start to end
+}
+
+void MazeGenerator::update(const int& frame_count, const int& fps) {
+  if (frame_count % fps != 0) return;
 
   if (state == IN_PROGRESS) {
-    if (!stack.empty()) {
-      Node* current = stack.top();  // Get the current node from the stack
-      int x = current->x * CELL_SIZE;
-      int y = current->y * CELL_SIZE;
-      DrawRectangle(x, y, CELL_SIZE, CELL_SIZE, PURPLE);  // Highlight the current node
-    }
-    if (frame_count % fps == 0) {
-      generate();
-    }
+    PROFILE_PHASE(ProfilePhase::GENERATION);
+    generate();  // no-op while a worker generates; its events go through consumeEvents()
   } else if (state == COMPLETED) {
-    for (int i = 0; i < total_path_nodes; i++) {
-      Node* node = path[i];
-      int x = node->x * CELL_SIZE;
-      int y = node->y * CELL_SIZE;
-      int t = 5;
-      DrawRectangle(x + t, y + t, CELL_SIZE - 2 * t, CELL_SIZE - 2 * t,
-                    GREEN);  // Highlight the path
-    }
-    if (frame_count % fps == 0) {
-      if (total_path_nodes < path.size()) {
-        total_path_nodes++;
-      }
+    if (total_path_nodes < static_cast<int>(path.size())) {
+      total_path_nodes++;
     }
   }
-
-  if (state != NOT_STARTED) {
-    // start and end points
-    DrawRectangle(0, 0, CELL_SIZE, CELL_SIZE, MAGENTA);
-    DrawRectangle((COLS - 1) * CELL_SIZE, (ROWS - 1) * CELL_SIZE, CELL_SIZE, CELL_SIZE, RED);
-  }
 }
 
-BoundingBox MazeGenerator::generateBBox(const Vector3& position, const BoxSize3D& dimensions) {
+AABB MazeGenerator::generateBBox(const Vec3& position, const BoxSize3D& dimensions) {
   return {{position.x - dimensions.width / 2, position.y - dimensions.height / 2,
            position.z - dimensions.depth / 2},
           {position.x + dimensions.width / 2, position.y + dimensions.height / 2,
            position.z + dimensions.depth / 2}};
 }
 
+AABB MazeGenerator::generateWallBBox(const WallRun& run) {
+  const BoxSize3D& cell = floor_dimension;
+  if (run.horizontal) {
+    const float z = run.line * cell.depth - cell.depth / 2;
+    return {{run.start * cell.width - cell.width / 2, 0.0f, z - wall_depth / 2},
+            {run.end * cell.width + cell.width / 2, wall_height, z + wall_depth / 2}};
+  }
+  const float x = run.line * cell.width - cell.width / 2;
+  return {{x - wall_depth / 2, 0.0f, run.start * cell.depth - cell.depth / 2},
+          {x + wall_depth / 2, wall_height, run.end * cell.depth + cell.depth / 2}};
+}
+
 void MazeGenerator::calcBoundingBoxes() {
-  for (const auto& cell : grid) {
-    // floor bbox
-    const Vector3 floor_pos = {cell->x * floor_dimension.width, 0.0f,
-                               cell->y * floor_dimension.depth};
-    const BoundingBox floor_bbox = generateBBox(floor_pos, floor_dimension);
-    floor_bboxes.push_back(floor_bbox);
-
-    // wall bbox
-    const BoxSize3D top_bottom_walls_dimensions = {floor_dimension.width, wall_height, wall_depth};
-    const BoxSize3D right_left_walls_dimensions = {wall_depth, wall_height, floor_dimension.depth};
-
-    if (cell->walls[0]) {
-      const Vector3 top_wall_pos = {floor_pos.x, floor_pos.y + wall_height / 2,
-                                    floor_pos.z - floor_dimension.depth / 2};
-
-      const BoundingBox top_wall_bbox = generateBBox(top_wall_pos, top_bottom_walls_dimensions);
-      wall_bboxes.push_back(top_wall_bbox);
-    }
-    if (cell->walls[1]) {
-      const Vector3 right_wall_pos = {floor_pos.x + floor_dimension.width / 2,
-                                      floor_pos.y + wall_height / 2, floor_pos.z};
+  const int cols = grid.getCols();
+  const int rows = grid.getRows();
+  std::vector<AABB> floor_boxes;
+  std::vector<AABB> wall_boxes;
+  floor_boxes.reserve(grid.getCellCount());
+  wall_runs.clear();
+
+  // floor bbox of every cell, in cell order
+  for (int cell = 0; cell < grid.getCellCount(); ++cell) {
+    const Vec3 floor_pos = {grid.cellX(cell) * floor_dimension.width, 0.0f,
+                            grid.cellY(cell) * floor_dimension.depth};
+    floor_boxes.push_back(generateBBox(floor_pos, floor_dimension));
+  }
 
-      const BoundingBox right_wall_bbox = generateBBox(right_wall_pos, right_left_walls_dimensions);
-      wall_bboxes.push_back(right_wall_bbox);
-    }
-    if (cell->walls[2]) {
-      const Vector3 bottom_wall_pos = {floor_pos.x, floor_pos.y + wall_height / 2,
-                                       floor_pos.z + floor_dimension.depth / 2};
+  // with shared borders the last grid lines are emitted by the neighbouring maze
+  const int last_horizontal_line = shared_borders ? rows - 1 : rows;
+  const int last_vertical_line = shared_borders ? cols - 1 : cols;
 
-      const BoundingBox bottom_wall_bbox =
-          generateBBox(bottom_wall_pos, top_bottom_walls_dimensions);
-      wall_bboxes.push_back(bottom_wall_bbox);
-    }
-    if (cell->walls[3]) {
-      const Vector3 left_wall_pos = {floor_pos.x - floor_dimension.width / 2,
-                                     floor_pos.y + wall_height / 2, floor_pos.z};
+  // horizontal walls: walk every horizontal grid line and merge consecutive segments
+  for (int line = 0; line <= last_horizontal_line; ++line) {
+    for (int x = 0; x < cols; ++x) {
+      if (!grid.hasHorizontalWall(x, line)) continue;
 
-      const BoundingBox left_wall_bbox = generateBBox(left_wall_pos, right_left_walls_dimensions);
-      wall_bboxes.push_back(left_wall_bbox);
+      const int start = x;
+      while (x + 1 < cols && grid.hasHorizontalWall(x + 1, line)) x++;
+      wall_runs.push_back({true, line, start, x});
     }
   }
-}
 
-void MazeGenerator::draw3D(const bool& show_path, const Texture2D& wall_texture,
-                           const Texture2D& floor_texture) {
-  if (state != COMPLETED) return;
-
-  for (const auto& cell : grid) {
-    // floor tiles
-    const Vector3 floor_pos = {cell->x * floor_dimension.width, 0.0f,
-                               cell->y * floor_dimension.depth};
-    const Color floor_color = LIGHTGRAY;
-
-    // DrawCube(floor_pos, floor_dimension.width, floor_dimension.height, floor_dimension.depth,
-    //          floor_color);
-    neuro_path_texture::DrawCubeTexture(floor_texture, floor_pos, floor_dimension.width,
-                                        floor_dimension.height, floor_dimension.depth, floor_color);
-    // DrawBoundingBox(floor_bboxes[cell->y * COLS + cell->x], RED);
-
-    // walls
-    const BoxSize3D top_bottom_walls_dimensions = {floor_dimension.width, wall_height, wall_depth};
-    const BoxSize3D right_left_walls_dimensions = {wall_depth, wall_height, floor_dimension.depth};
-    const Color wall_color = GRAY;
-
-    if (cell->walls[0]) {  // top
-      const Vector3 top_wall_pos = {floor_pos.x, floor_pos.y + wall_height / 2,
-                                    floor_pos.z - floor_dimension.depth / 2};
-      // DrawCube(top_wall_pos, top_bottom_walls_dimensions.width,
-      // top_bottom_walls_dimensions.height,
-      //          top_bottom_walls_dimensions.depth, BLACK);
-      neuro_path_texture::DrawCubeTexture(
-          wall_texture, top_wall_pos, top_bottom_walls_dimensions.width,
-          top_bottom_walls_dimensions.height, top_bottom_walls_dimensions.depth, wall_color);
-    }
-    if (cell->walls[1]) {  // right
-      const Vector3 right_wall_pos = {floor_pos.x + floor_dimension.width / 2,
-                                      floor_pos.y + wall_height / 2, floor_pos.z};
-      // DrawCube(right_wall_pos, right_left_walls_dimensions.width,
-      //          right_left_walls_dimensions.height, right_left_walls_dimensions.depth, BLACK);
-      neuro_path_texture::DrawCubeTexture(
-          wall_texture, right_wall_pos, right_left_walls_dimensions.width,
-          right_left_walls_dimensions.height, right_left_walls_dimensions.depth, wall_color);
-    }
-    if (cell->walls[2]) {  // bottom
-      const Vector3 bottom_wall_pos = {floor_pos.x, floor_pos.y + wall_height / 2,
-                                       floor_pos.z + floor_dimension.depth / 2};
-      // DrawCube(bottom_wall_pos, top_bottom_walls_dimensions.width,
-      //          top_bottom_walls_dimensions.height, top_bottom_walls_dimensions.depth, BLACK);
-      neuro_path_texture::DrawCubeTexture(
-          wall_texture, bottom_wall_pos, top_bottom_walls_dimensions.width,
-          top_bottom_walls_dimensions.height, top_bottom_walls_dimensions.depth, wall_color);
-    }
-    if (cell->walls[3]) {  // left
-      const Vector3 left_wall_pos = {floor_pos.x - floor_dimension.width / 2,
-                                     floor_pos.y + wall_height / 2, floor_pos.z};
-      // DrawCube(left_wall_pos, right_left_walls_dimensions.width,
-      // right_left_walls_dimensions.height,
-      //          right_left_walls_dimensions.depth, BLACK);
-      neuro_path_texture::DrawCubeTexture(
-          wall_texture, left_wall_pos, right_left_walls_dimensions.width,
-          right_left_walls_dimensions.height, right_left_walls_dimensions.depth, wall_color);
+  // vertical walls: same along every vertical grid line
+  for (int line = 0; line <= last_vertical_line; ++line) {
+    for (int y = 0; y < rows; ++y) {
+      if (!grid.hasVerticalWall(line, y)) continue;
+
+      const int start = y;
+      while (y + 1 < rows && grid.hasVerticalWall(line, y + 1)) y++;
+      wall_runs.push_back({false, line, start, y});
     }
   }
 
-  // debugging
-  // for (const auto& wall_bbox : wall_bboxes) {
-  //   DrawBoundingBox(wall_bbox, RED);
-  // }
-
-  // draw the path
-  if (show_path) {
-    for (const auto& cell : path) {
-      const BoxSize3D path_tile_dimension = {0.5f, 0.2f, 0.5f};
-      const Vector3 path_cell_pos = {cell->x * floor_dimension.width, 0.1f,
-                                     cell->y * floor_dimension.depth};
-      DrawCube(path_cell_pos, path_tile_dimension.width, path_tile_dimension.height,
-               path_tile_dimension.depth, GREEN);
-    }
+  wall_boxes.reserve(wall_runs.size());
+  for (const WallRun& run : wall_runs) {
+    wall_boxes.push_back(generateWallBBox(run));
   }
+
+  // index the boxes by the cell they overlap; cell (0, 0) is centered on the origin
+  const Vec3 origin = {-floor_dimension.width / 2, 0.0f, -floor_dimension.depth / 2};
+  floor_bboxes.build(std::move(floor_boxes), grid.getCols(), grid.getRows(),
+                     floor_dimension.width, floor_dimension.depth, origin);
+  wall_bboxes.build(std::move(wall_boxes), grid.getCols(), grid.getRows(), floor_dimension.width,
+                    floor_dimension.depth, origin);
 }
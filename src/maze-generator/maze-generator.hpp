@@ -2,76 +2,187 @@
 Maze Generation - Graph-based Algorithm
 
 This code implements a maze generation algorithm using a graph-based approach.
+It only holds the maze logic (generation, solving and 3D bounding boxes) and has no raylib
+dependency; drawing lives in the maze renderer.
 */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <stack>
+#include <random>
+#include <thread>
+#include <utility>
 #include <vector>
 
-#include "raylib.h"
-#include "utils/helper.hpp"
-#include "utils/texture.hpp"
+#include "collision/collision-grid.hpp"
+#include "concurrency/thread-pool.hpp"
+#include "concurrency/spsc-queue.hpp"
+#include "generation-strategy.hpp"
+#include "maze-grid.hpp"
+#include "solver/flow-field.hpp"
 #include "utils/types.hpp"
 
 // Enum to represent the state of the maze generation
 enum GenerationState { NOT_STARTED, IN_PROGRESS, COMPLETED, FAILED };
 
-// Structure representing a cell in the maze
-struct Node {
-  int x;          // x-coordinate of the node
-  int y;          // y-coordinate of the node
-  bool visited;   // flag to check if the node has been visited
-  bool walls[4];  // walls around the node (top, right, bottom, left)
-  Node* parent;   // pointer to the parent node (for pathfinding)
+// Kind of change published by the generation worker
+enum class GenerationEventType : uint8_t {
+  CARVE,  // wall removed on side `dir` of `cell`
+  VISIT,  // `cell` joined the maze
+  STEP    // a generation step ended with `cell` as the current cell
+};
+
+// Change published by the generation worker to the thread animating the maze
+struct GenerationEvent {
+  int32_t cell;
+  GenerationEventType type;
+  uint8_t dir;
+};
 
-  Node(int x, int y) : x(x), y(y), visited(false), walls{true, true, true, true}, parent(nullptr) {}
+// Run of collinear wall segments merged into a single wall
+struct WallRun {
+  bool horizontal;  // along a horizontal grid line (x axis) or a vertical one (z axis)
+  int line;         // grid line index (0..rows for horizontal, 0..cols for vertical)
+  int start;        // first cell along the line
+  int end;          // last cell along the line (inclusive)
 };
 
 // MazeGenerator class to generate a maze
 class MazeGenerator {
+ public:
+  static constexpr int REGION_SIZE = 16;  // cells per side of a change-tracking region
+
  private:
-  const int CELL_SIZE = 20;                              // size of each cell in the maze
-  const int WIDTH;                                       // width of the maze
-  const int HEIGHT;                                      // height of the maze
-  const int COLS;                                        // number of columns in the maze
-  const int ROWS;                                        // number of rows in the maze
   const BoxSize3D floor_dimension = {2.0f, 0.2f, 2.0f};  // dimensions of the floor tile in 3D space
   const float wall_height = 1.5f;                        // height of wall
   const float wall_depth = 0.2f;                         // depth of wall
   int total_path_nodes = 0;                              // total nodes in path at ith frame
-  std::vector<std::unique_ptr<Node>> grid;               // 1D array of nodes representing the maze
-  std::vector<std::pair<int, int>> directions = {
-      {0, -1},  // top
-      {1, 0},   // right
-      {0, 1},   // bottom
-      {-1, 0}   // left
-  };
-  GenerationState state = NOT_STARTED;    // current state of the maze generation
-  std::stack<Node*> stack;                // stack for depth-first search
-  std::vector<Node*> path;                // vector to hold the path from start to end
-  std::vector<BoundingBox> floor_bboxes;  // vector to hold bounding boxes for floor in 3D
-  std::vector<BoundingBox> wall_bboxes;   // vector to hold bounding boxes for walls in 3D
-
-  // Depth-first search algorithm to generate the maze
-  void generate();
-  // Remove wall between two nodes
-  void removeWall(Node* a, Node* b);
-  // calculate the path from start to end
-  void calcPath();
-  // calculate the bounding boxes for the floor and walls in 3D
-  void calcBoundingBoxes();
+  MazeGrid grid;                                         // compact grid of cells
+  GenerationState state = NOT_STARTED;  // current state of the maze generation
+  GenerationAlgorithm algorithm = GenerationAlgorithm::DFS;  // algorithm carving the maze
+  std::unique_ptr<GenerationStrategy> strategy;               // running algorithm
+  uint32_t seed;                        // seed of rng, so a maze can be generated again
+  std::mt19937 rng;                     // random source of the generation
+  std::vector<int> path;                // ids of the cells on the path from start to end
+  FlowField flow_field;                 // distance and next move to the exit from every cell
+  CollisionGrid floor_bboxes;           // bounding boxes for floor in 3D, indexed by cell
+  CollisionGrid wall_bboxes;            // bounding boxes for walls in 3D, indexed by cell
+  std::vector<WallRun> wall_runs;       // wall run of each wall bounding box
+  std::vector<std::pair<int, int>> border_openings;  // (cell, direction) of border walls to open
+  bool shared_borders = false;  // bottom and right border walls belong to a neighbouring maze
+
+  // off-thread generation: the worker carves its own grid and publishes every change as events,
+  // which are applied to `grid` by the thread animating the maze
+  static constexpr std::size_t EVENT_QUEUE_CAPACITY = 1 << 14;
+  std::thread worker;                                      // generation worker thread
+  std::unique_ptr<MazeGrid> worker_grid;                   // grid carved by the worker
+  std::unique_ptr<SpscQueue<GenerationEvent>> events;      // worker -> animation events
+  std::atomic<bool> skip_requested{false};    // worker stops publishing events
+  std::atomic<bool> cancel_requested{false};  // worker stops as soon as possible
+  std::atomic<bool> worker_done{false};       // worker published its last event
+  int event_current = MazeGrid::NO_CELL;      // current cell according to the applied events
+
+  // change tracking for incremental redraws: the regions touched by a batch of changes are
+  // stamped with a new revision
+  bool tracking_changes = false;           // log the changes of grid
+  std::vector<GridChange> grid_changes;    // changes of grid not stamped yet
+  std::vector<uint32_t> region_revisions;  // revision of the last change in each region
+  uint32_t revision = 0;                   // revision of the last change anywhere
+  uint32_t full_revision = 0;              // revision of the last change to the whole grid
+
+  // Apply the end of the generation (parent tree, border openings) to a fully carved grid
+  void completeGrid(MazeGrid& target);
+  // Mark the maze as completed and build the path and bounding boxes
+  void completeGeneration();
+  // Body of the generation worker thread
+  void runWorker();
+  // Push an event, waiting while the queue is full; false if the worker stops publishing
+  bool publish(const GenerationEvent& event);
+  // Stamp the regions of the logged grid changes with a new revision
+  void stampChanges();
+  // Stamp the whole grid with a new revision (state change, grid replaced)
+  void stampAll() { full_revision = ++revision; }
+
   // Generate a bounding box for a given position and dimensions
-  BoundingBox generateBBox(const Vector3& position, const BoxSize3D& dimensions);
+  AABB generateBBox(const Vec3& position, const BoxSize3D& dimensions);
+  // Generate the bounding box of a wall run
+  AABB generateWallBBox(const WallRun& run);
 
  public:
-  MazeGenerator(const int& width, const int& height);
+  MazeGenerator(const int& cols, const int& rows, CellOrder order = CellOrder::ROW_MAJOR);
+  ~MazeGenerator();
+
+  MazeGenerator(const MazeGenerator&) = delete;
+  MazeGenerator& operator=(const MazeGenerator&) = delete;
 
   GenerationState getState() const { return state; }
-  const std::vector<BoundingBox>& getFloorBBoxes() const { return floor_bboxes; }
-  const std::vector<BoundingBox>& getWallBBoxes() const { return wall_bboxes; }
+  const MazeGrid& getGrid() const { return grid; }
+  GenerationAlgorithm getAlgorithm() const { return algorithm; }
+  uint32_t getSeed() const { return seed; }
+  // Cell highlighted by the animation, NO_CELL if there is none
+  int getCurrentCell() const;
+  const std::vector<int>& getPath() const { return path; }
+  // Distance and next move to the exit (the last cell), built when the generation completes
+  const FlowField& getFlowField() const { return flow_field; }
+  // Get the cell under a 3D position, NO_CELL outside the maze
+  int getCellAt(const Vec3& position) const;
+  int getRevealedPathNodes() const { return total_path_nodes; }
+  const BoxSize3D& getFloorDimension() const { return floor_dimension; }
+  const std::vector<AABB>& getFloorBBoxes() const { return floor_bboxes.getBoxes(); }
+  const std::vector<AABB>& getWallBBoxes() const { return wall_bboxes.getBoxes(); }
+  const CollisionGrid& getFloorIndex() const { return floor_bboxes; }
+  const CollisionGrid& getWallIndex() const { return wall_bboxes; }
+  const std::vector<WallRun>& getWallRuns() const { return wall_runs; }
+  float getWallHeight() const { return wall_height; }
+  float getWallDepth() const { return wall_depth; }
+  bool hasSharedBorders() const { return shared_borders; }
+  // Revision of the last change that affects how the cells of a region are drawn (walls,
+  // visited cells, generation state); only tracked after setChangeTracking(true)
+  uint32_t getRegionRevision(int region_x, int region_y) const;
+  uint32_t getRevision() const { return revision; }
+
+  // Choose the generation algorithm; ignored once the generation has started
+  void setAlgorithm(GenerationAlgorithm new_algorithm);
+  // Seed the generation for a reproducible maze; ignored once the generation has started
+  void setSeed(uint32_t seed);
+  // Open a wall on the outer border once the maze is carved, to connect it to a neighbouring
+  // maze; ignored once the generation has started
+  void addBorderOpening(int cell, int dir);
+  // Leave the bottom and right border walls out of the bounding boxes, for mazes tiled next to
+  // each other where the neighbour emits them; ignored once the generation has started
+  void setSharedBorders(bool shared);
+  // Track which regions of the grid change, for views redrawing only what changed; ignored
+  // once the generation has started
+  void setChangeTracking(bool enable);
 
   void start_generation();
-  void draw(const int& frame_count, const int& fps);
-  void draw3D(const bool& show_path, const Texture2D& wall_texture, const Texture2D& floor_texture);
+  // Start generating on a worker thread; the changes reach the grid through consumeEvents()
+  void start_async_generation();
+  // Apply the worker's events to the grid, up to max_steps generation steps or until the time
+  // budget runs out; completes the maze once the worker is done. Never blocks.
+  // Returns the number of events applied.
+  int consumeEvents(int max_steps, double budget_seconds);
+  // Jump straight to the finished maze: the worker stops publishing and the pending events are
+  // dropped; the maze completes in a later consumeEvents() call
+  void skip_generation();
+  bool isGeneratingAsync() const { return worker.joinable(); }
+  // Run the generation to completion without animating it
+  void finish_generation();
+  // Generate the whole maze at once from independent tiles carved on a thread pool and stitched
+  // together (see tiled-generation.hpp); a different maze than the step-wise generation with the
+  // same seed. Ignored once the generation has started.
+  void tiled_generation(ThreadPool& thread_pool);
+  // Use walls carved elsewhere (packed row-major, see MazeGrid::packWalls) and complete the maze
+  // at once; ignored once the generation has started
+  void load_walls(const uint8_t* packed_walls);
+  // Advance the generation by a single step
+  void generate();
+  // calculate the path from start to end
+  void calcPath();
+  // calculate the bounding boxes for the floor and walls in 3D, and index them by cell.
+  // Every wall is emitted once, with collinear neighbours merged into a single box.
+  void calcBoundingBoxes();
+  // Advance the generation (or the path reveal once completed) every fps-th frame
+  void update(const int& frame_count, const int& fps);
 };
@@ -0,0 +1,112 @@
+#include "maze-grid.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+MazeGrid::MazeGrid(int cols, int rows, CellOrder order) : cols(cols), rows(rows), order(order) {
+  if (order == CellOrder::TILED) {
+    // pad the grid to whole tiles so every tile owns a contiguous block of storage
+    tiles_per_row = (cols + TILE_SIZE - 1) / TILE_SIZE;
+    const int tiles_per_col = (rows + TILE_SIZE - 1) / TILE_SIZE;
+    storage_cells = static_cast<std::size_t>(tiles_per_row) * tiles_per_col * TILE_CELLS;
+  } else {
+    storage_cells = static_cast<std::size_t>(cols) * rows;
+  }
+
+  walls.resize((storage_cells + 1) / 2);
+  parents.resize((storage_cells + 3) / 4);
+  visited.resize((storage_cells + 63) / 64);
+  reset();
+}
+
+void MazeGrid::reset() {
+  std::fill(walls.begin(), walls.end(), static_cast<uint8_t>(ALL_WALLS | (ALL_WALLS << 4)));
+  std::fill(parents.begin(), parents.end(), 0);
+  std::fill(visited.begin(), visited.end(), 0);
+  root = NO_CELL;
+}
+
+void MazeGrid::removeWall(int cell, int dir) {
+  const int neighbor = getNeighbor(cell, dir);
+  if (change_log) change_log->push_back({cell, dir});
+
+  std::size_t i = storageIndex(cell);
+  walls[i >> 1] &= ~static_cast<uint8_t>(wallBit(dir) << ((i & 1) << 2));
+
+  if (neighbor != NO_CELL) {
+    i = storageIndex(neighbor);
+    walls[i >> 1] &= ~static_cast<uint8_t>(wallBit(oppositeDirection(dir)) << ((i & 1) << 2));
+  }
+}
+
+void MazeGrid::setVisited(int cell) {
+  const std::size_t i = storageIndex(cell);
+  visited[i >> 6] |= uint64_t{1} << (i & 63);
+  if (change_log) change_log->push_back({cell, VISIT_CHANGE});
+}
+
+int MazeGrid::getParentDirection(int cell) const {
+  const std::size_t i = storageIndex(cell);
+  return (parents[i >> 2] >> ((i & 3) << 1)) & 3;
+}
+
+void MazeGrid::setParentDirection(int cell, int dir) {
+  const std::size_t i = storageIndex(cell);
+  const int shift = static_cast<int>((i & 3) << 1);
+  parents[i >> 2] = static_cast<uint8_t>((parents[i >> 2] & ~(3 << shift)) | (dir << shift));
+}
+
+int MazeGrid::getParent(int cell) const {
+  if (cell == root) return NO_CELL;
+  return getNeighbor(cell, getParentDirection(cell));
+}
+
+void MazeGrid::buildParentTree(int cell) {
+  std::fill(visited.begin(), visited.end(), 0);
+  root = cell;
+  setVisited(cell);
+
+  // depth-first walk over the open passages; the parent codes written so far are the stack
+  while (cell != NO_CELL) {
+    int next = NO_CELL;
+    for (int dir = TOP; dir <= LEFT && next == NO_CELL; ++dir) {
+      if (hasWall(cell, dir)) continue;
+      const int neighbor = getNeighbor(cell, dir);
+      if (neighbor == NO_CELL || isVisited(neighbor)) continue;
+
+      setParentDirection(neighbor, oppositeDirection(dir));
+      setVisited(neighbor);
+      next = neighbor;
+    }
+    cell = next != NO_CELL ? next : getParent(cell);
+  }
+}
+
+void MazeGrid::packWalls(uint8_t* out) const {
+  if (order == CellOrder::ROW_MAJOR) {
+    std::memcpy(out, walls.data(), getPackedWallsSize());
+    return;
+  }
+  std::memset(out, 0, getPackedWallsSize());
+  for (int cell = 0; cell < getCellCount(); ++cell) {
+    out[cell >> 1] |= static_cast<uint8_t>(getWalls(cell) << ((cell & 1) << 2));
+  }
+}
+
+void MazeGrid::unpackWalls(const uint8_t* packed) {
+  if (order == CellOrder::ROW_MAJOR) {
+    std::memcpy(walls.data(), packed, getPackedWallsSize());
+    return;
+  }
+  for (int cell = 0; cell < getCellCount(); ++cell) {
+    const std::size_t i = storageIndex(cell);
+    const uint8_t mask = (packed[cell >> 1] >> ((cell & 1) << 2)) & ALL_WALLS;
+    const int shift = static_cast<int>((i & 1) << 2);
+    walls[i >> 1] = static_cast<uint8_t>((walls[i >> 1] & ~(ALL_WALLS << shift)) | (mask << shift));
+  }
+}
+
+std::size_t MazeGrid::getMemoryUsage() const {
+  return walls.capacity() * sizeof(uint8_t) + parents.capacity() * sizeof(uint8_t) +
+         visited.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,153 @@
+/*
+Maze Grid - Compact cell storage
+
+Cells are addressed by their logical id (y * cols + x). Internally the walls of a cell are
+stored as a 4-bit mask (two cells per byte), the parent of a cell as a 2-bit direction code
+(four cells per byte) and the visited flags in a bitset, so a cell costs less than one byte.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Direction codes shared by walls, parents and neighbour lookups
+enum Direction : uint8_t { TOP = 0, RIGHT = 1, BOTTOM = 2, LEFT = 3 };
+
+// Order in which cells are laid out in memory
+enum class CellOrder {
+  ROW_MAJOR,  // row by row, same as the logical ids
+  TILED       // 8x8 tiles stored row by row, cells in Morton (Z) order inside a tile
+};
+
+// Get the direction pointing back the other way
+inline constexpr int oppositeDirection(int dir) { return (dir + 2) & 3; }
+
+// Wall mask bit for a direction
+inline constexpr uint8_t wallBit(int dir) { return static_cast<uint8_t>(1u << dir); }
+
+// Change made to a grid, recorded while a change log is attached
+struct GridChange {
+  int cell;  // changed cell
+  int dir;   // wall removed on that side of the cell, or VISIT_CHANGE if the cell was visited
+};
+
+// GridChange::dir of a cell being marked as visited
+constexpr int VISIT_CHANGE = -1;
+
+// MazeGrid class holding the walls, visited flags and parents of every cell
+class MazeGrid {
+ public:
+  static constexpr int NO_CELL = -1;         // id returned when there is no such cell
+  static constexpr uint8_t ALL_WALLS = 0xF;  // wall mask with all four walls standing
+
+ private:
+  static constexpr int TILE_SHIFT = 3;               // tiles are 8x8 cells
+  static constexpr int TILE_SIZE = 1 << TILE_SHIFT;  // cells per tile side
+  static constexpr int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+
+  int cols = 0;                            // number of columns in the maze
+  int rows = 0;                            // number of rows in the maze
+  CellOrder order = CellOrder::ROW_MAJOR;  // memory layout of the cells
+  int tiles_per_row = 0;                   // number of tiles in a row (TILED order only)
+  std::size_t storage_cells = 0;           // number of cell slots including tile padding
+  int root = NO_CELL;                      // root of the parent tree (cell without a parent)
+  std::vector<uint8_t> walls;              // 4-bit wall masks, two cells per byte
+  std::vector<uint8_t> parents;            // 2-bit parent direction codes, four cells per byte
+  std::vector<uint64_t> visited;           // visited flags, one bit per cell
+  std::vector<GridChange>* change_log = nullptr;  // receives wall removals and visits, if set
+
+  // Interleave the low three bits of x and y (Morton order inside a tile)
+  static std::size_t mortonIndex(int x, int y) {
+    return (x & 1) | ((y & 1) << 1) | ((x & 2) << 1) | ((y & 2) << 2) | ((x & 4) << 2) |
+           ((y & 4) << 3);
+  }
+
+  // Convert a logical cell id to its slot in the storage arrays
+  std::size_t storageIndex(int cell) const {
+    if (order == CellOrder::ROW_MAJOR) return static_cast<std::size_t>(cell);
+    const int x = cell % cols;
+    const int y = cell / cols;
+    const std::size_t tile =
+        static_cast<std::size_t>(y >> TILE_SHIFT) * tiles_per_row + (x >> TILE_SHIFT);
+    return tile * TILE_CELLS + mortonIndex(x, y);
+  }
+
+ public:
+  MazeGrid(int cols, int rows, CellOrder order = CellOrder::ROW_MAJOR);
+
+  int getCols() const { return cols; }
+  int getRows() const { return rows; }
+  int getCellCount() const { return cols * rows; }
+  CellOrder getOrder() const { return order; }
+  int getRoot() const { return root; }
+
+  int cellId(int x, int y) const { return y * cols + x; }
+  int cellX(int cell) const { return cell % cols; }
+  int cellY(int cell) const { return cell / cols; }
+
+  // Get the cell next to the given one, NO_CELL if it lies outside the maze
+  int getNeighbor(int cell, int dir) const {
+    switch (dir) {
+      case TOP:
+        return cell >= cols ? cell - cols : NO_CELL;
+      case RIGHT:
+        return (cell % cols) + 1 < cols ? cell + 1 : NO_CELL;
+      case BOTTOM:
+        return cell + cols < cols * rows ? cell + cols : NO_CELL;
+      default:
+        return (cell % cols) > 0 ? cell - 1 : NO_CELL;
+    }
+  }
+
+  uint8_t getWalls(int cell) const {
+    const std::size_t i = storageIndex(cell);
+    return (walls[i >> 1] >> ((i & 1) << 2)) & ALL_WALLS;
+  }
+  bool hasWall(int cell, int dir) const { return (getWalls(cell) & wallBit(dir)) != 0; }
+  // Remove the wall on the given side of a cell, and the matching wall of the neighbour
+  void removeWall(int cell, int dir);
+
+  // Check for a wall on horizontal grid line `line` (0..rows) at column x; false outside the maze
+  bool hasHorizontalWall(int x, int line) const {
+    if (x < 0 || x >= cols || line < 0 || line > rows) return false;
+    return line < rows ? hasWall(cellId(x, line), TOP) : hasWall(cellId(x, rows - 1), BOTTOM);
+  }
+  // Check for a wall on vertical grid line `line` (0..cols) at row y; false outside the maze
+  bool hasVerticalWall(int line, int y) const {
+    if (y < 0 || y >= rows || line < 0 || line > cols) return false;
+    return line < cols ? hasWall(cellId(line, y), LEFT) : hasWall(cellId(cols - 1, y), RIGHT);
+  }
+
+  bool isVisited(int cell) const {
+    const std::size_t i = storageIndex(cell);
+    return (visited[i >> 6] >> (i & 63)) & 1u;
+  }
+  void setVisited(int cell);
+
+  // Get the parent of a cell, NO_CELL for the root
+  int getParent(int cell) const;
+  // Get the direction code from a cell to its parent
+  int getParentDirection(int cell) const;
+  void setParentDirection(int cell, int dir);
+  void setRoot(int cell) { root = cell; }
+  // Point the parent codes along the open passages towards `cell`, which becomes the root.
+  // Leaves every reachable cell visited.
+  void buildParentTree(int cell);
+
+  // Record every later wall removal and visit in `log`; nullptr stops recording
+  void setChangeLog(std::vector<GridChange>* log) { change_log = log; }
+
+  // Bytes of the walls packed row-major, two cells per byte (even cells in the low nibble)
+  std::size_t getPackedWallsSize() const { return (static_cast<std::size_t>(cols) * rows + 1) / 2; }
+  // Write the walls packed row-major into `out` (getPackedWallsSize() bytes)
+  void packWalls(uint8_t* out) const;
+  // Replace the walls with packed row-major ones (getPackedWallsSize() bytes); a single copy
+  // for ROW_MAJOR grids. Visited flags and parents are left alone.
+  void unpackWalls(const uint8_t* packed);
+
+  // Restore all walls and clear the visited flags and parents
+  void reset();
+  // Bytes used by the cell storage
+  std::size_t getMemoryUsage() const;
+};
@@ -0,0 +1,54 @@
+#include "prim-strategy.hpp"
+
+#include "utils/random.hpp"
+
+void PrimStrategy::addFrontier(const MazeGrid& grid, int cell) {
+  for (int dir = TOP; dir <= LEFT; ++dir) {
+    const int neighbor = grid.getNeighbor(cell, dir);
+    if (neighbor == MazeGrid::NO_CELL || grid.isVisited(neighbor)) continue;
+
+    uint64_t& word = in_frontier[neighbor >> 6];
+    const uint64_t bit = uint64_t{1} << (neighbor & 63);
+    if (word & bit) continue;
+    word |= bit;
+    frontier.push_back(neighbor);
+  }
+}
+
+void PrimStrategy::start(MazeGrid& grid, std::mt19937&) {
+  frontier.clear();
+  in_frontier.assign((grid.getCellCount() + 63) / 64, 0);
+
+  current = 0;
+  grid.setVisited(current);
+  addFrontier(grid, current);
+}
+
+bool PrimStrategy::step(MazeGrid& grid, std::mt19937& rng) {
+  if (frontier.empty()) {
+    current = MazeGrid::NO_CELL;
+    return false;
+  }
+
+  // take a random frontier cell (swap with the last one to remove it in O(1))
+  const int index = helper::getRandomIndex(rng, static_cast<int>(frontier.size()));
+  const int cell = frontier[index];
+  frontier[index] = frontier.back();
+  frontier.pop_back();
+
+  // connect it to a random neighbour already in the maze
+  int candidates[4];
+  int count = 0;
+  for (int dir = TOP; dir <= LEFT; ++dir) {
+    const int neighbor = grid.getNeighbor(cell, dir);
+    if (neighbor != MazeGrid::NO_CELL && grid.isVisited(neighbor)) {
+      candidates[count++] = dir;
+    }
+  }
+  grid.removeWall(cell, candidates[helper::getRandomIndex(rng, count)]);
+  grid.setVisited(cell);
+  addFrontier(grid, cell);
+
+  current = cell;
+  return true;
+}
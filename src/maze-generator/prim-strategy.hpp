@@ -0,0 +1,26 @@
+/*
+Randomized Prim's algorithm
+
+Grows the maze from the first cell by repeatedly connecting a random frontier cell (a cell next to
+the maze) to the maze. Produces short, branchy corridors radiating from the start.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "generation-strategy.hpp"
+
+class PrimStrategy : public GenerationStrategy {
+  std::vector<int> frontier;            // cells next to the maze, not in it yet
+  std::vector<uint64_t> in_frontier;    // frontier membership, one bit per cell
+  int current = MazeGrid::NO_CELL;      // last cell added to the maze
+
+  // Add the neighbours of a cell that are neither in the maze nor in the frontier
+  void addFrontier(const MazeGrid& grid, int cell);
+
+ public:
+  void start(MazeGrid& grid, std::mt19937& rng) override;
+  bool step(MazeGrid& grid, std::mt19937& rng) override;
+  int getCurrentCell() const override { return current; }
+};
@@ -0,0 +1,127 @@
+#include "tiled-generation.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Mix a seed with tile coordinates and a salt into a well-distributed 64-bit value
+uint64_t hashTile(uint32_t seed, int x, int y, uint32_t salt) {
+  uint64_t h = (static_cast<uint64_t>(seed) << 32) ^ salt;
+  h ^= static_cast<uint64_t>(static_cast<uint32_t>(x)) * 0x9E3779B97F4A7C15ull;
+  h ^= static_cast<uint64_t>(static_cast<uint32_t>(y)) * 0xC2B2AE3D27D4EB4Full;
+  // splitmix64 finalizer
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return h ^ (h >> 31);
+}
+
+// Salts of the values hashed per tile
+enum TileHash : uint32_t {
+  HASH_TILE_SEED = 1,      // seed of the tile's maze
+  HASH_SEAMS = 2,          // order in which the seams are offered to the union-find
+  HASH_RIGHT_OPENING = 3,  // row of the opening in the seam right of a tile
+  HASH_BOTTOM_OPENING = 4  // column of the opening in the seam below a tile
+};
+
+// Seam between a tile and its right (or bottom) neighbour
+struct Seam {
+  int tile;         // tile on the left (or top) of the seam
+  bool horizontal;  // between a tile and the one below it
+};
+
+// Find the representative of a tile's set
+int findSet(std::vector<int>& sets, int tile) {
+  while (sets[tile] != tile) {
+    sets[tile] = sets[sets[tile]];  // path halving
+    tile = sets[tile];
+  }
+  return tile;
+}
+
+// Carve tile (tile_x, tile_y) on its own grid and copy its open walls into `grid`. Only walls
+// inside the tile are removed, so tiles in different bands touch disjoint storage.
+void carveTile(MazeGrid& grid, GenerationAlgorithm algorithm, uint32_t seed, int tile_x,
+               int tile_y) {
+  const int x0 = tile_x * TILED_GENERATION_TILE;
+  const int y0 = tile_y * TILED_GENERATION_TILE;
+  const int width = std::min(TILED_GENERATION_TILE, grid.getCols() - x0);
+  const int height = std::min(TILED_GENERATION_TILE, grid.getRows() - y0);
+
+  MazeGrid tile(width, height);
+  std::mt19937 rng(static_cast<uint32_t>(hashTile(seed, tile_x, tile_y, HASH_TILE_SEED)));
+  std::unique_ptr<GenerationStrategy> strategy = createGenerationStrategy(algorithm);
+  strategy->start(tile, rng);
+  while (strategy->step(tile, rng)) {
+  }
+
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const uint8_t walls = tile.getWalls(tile.cellId(x, y));
+      const int cell = grid.cellId(x0 + x, y0 + y);
+      if (x + 1 < width && !(walls & wallBit(RIGHT))) grid.removeWall(cell, RIGHT);
+      if (y + 1 < height && !(walls & wallBit(BOTTOM))) grid.removeWall(cell, BOTTOM);
+    }
+  }
+}
+
+}  // namespace
+
+void generateTiledMaze(MazeGrid& grid, GenerationAlgorithm algorithm, uint32_t seed,
+                       ThreadPool* pool) {
+  const int tiles_x = (grid.getCols() + TILED_GENERATION_TILE - 1) / TILED_GENERATION_TILE;
+  const int tiles_y = (grid.getRows() + TILED_GENERATION_TILE - 1) / TILED_GENERATION_TILE;
+
+  // a band is one row of tiles; its cells are a contiguous block of storage in either order
+  auto carveBands = [&](int begin, int end) {
+    for (int tile_y = begin; tile_y < end; ++tile_y) {
+      for (int tile_x = 0; tile_x < tiles_x; ++tile_x) {
+        carveTile(grid, algorithm, seed, tile_x, tile_y);
+      }
+    }
+  };
+  if (pool && pool->getThreadCount() > 0) {
+    pool->parallelFor(tiles_y, carveBands);
+  } else {
+    carveBands(0, tiles_y);
+  }
+
+  // every tile is now connected inside; join the tiles along a random spanning tree of seams
+  std::vector<Seam> seams;
+  seams.reserve(static_cast<std::size_t>(tiles_x) * tiles_y * 2);
+  for (int tile = 0; tile < tiles_x * tiles_y; ++tile) {
+    if (tile % tiles_x + 1 < tiles_x) seams.push_back({tile, false});
+    if (tile / tiles_x + 1 < tiles_y) seams.push_back({tile, true});
+  }
+  std::mt19937 rng(static_cast<uint32_t>(hashTile(seed, 0, 0, HASH_SEAMS)));
+  std::shuffle(seams.begin(), seams.end(), rng);
+
+  std::vector<int> sets(static_cast<std::size_t>(tiles_x) * tiles_y);
+  std::iota(sets.begin(), sets.end(), 0);
+  for (const Seam& seam : seams) {
+    const int neighbor = seam.tile + (seam.horizontal ? tiles_x : 1);
+    const int a = findSet(sets, seam.tile);
+    const int b = findSet(sets, neighbor);
+    if (a == b) continue;
+    sets[a] = b;
+
+    // open one wall at a random cell along the seam
+    const int tile_x = seam.tile % tiles_x;
+    const int tile_y = seam.tile / tiles_x;
+    const int x0 = tile_x * TILED_GENERATION_TILE;
+    const int y0 = tile_y * TILED_GENERATION_TILE;
+    const int length = seam.horizontal ? std::min(TILED_GENERATION_TILE, grid.getCols() - x0)
+                                       : std::min(TILED_GENERATION_TILE, grid.getRows() - y0);
+    const uint32_t salt = seam.horizontal ? HASH_BOTTOM_OPENING : HASH_RIGHT_OPENING;
+    const int offset = static_cast<int>(hashTile(seed, tile_x, tile_y, salt) %
+                                        static_cast<uint64_t>(length));
+    if (seam.horizontal) {
+      grid.removeWall(grid.cellId(x0 + offset, y0 + TILED_GENERATION_TILE - 1), BOTTOM);
+    } else {
+      grid.removeWall(grid.cellId(x0 + TILED_GENERATION_TILE - 1, y0 + offset), RIGHT);
+    }
+  }
+}
@@ -0,0 +1,26 @@
+/*
+Tiled Generation - Whole-maze generation split across cores
+
+Cuts the grid into square tiles and carves each one as an independent perfect maze with any
+generation algorithm, one band of tiles per job on a thread pool. The tiles are then joined by a
+union-find pass over the seams between them: it opens one wall on exactly the seams of a random
+spanning tree of the tiles, so the result is again a perfect maze (a single path between any two
+cells). Every tile is seeded from the maze seed and its position, so the maze does not depend on
+the number of threads.
+*/
+#pragma once
+
+#include <cstdint>
+
+#include "concurrency/thread-pool.hpp"
+#include "generation-strategy.hpp"
+#include "maze-grid.hpp"
+
+// Cells per side of a tile; a multiple of 8 so that bands of tiles never share storage bytes
+constexpr int TILED_GENERATION_TILE = 64;
+
+// Carve a perfect maze into a grid with all walls standing, tile by tile on the pool (nullptr:
+// on the calling thread). Only walls are written: visited flags and parents are left alone.
+// The grid must have no change log attached while the tiles are carved in parallel.
+void generateTiledMaze(MazeGrid& grid, GenerationAlgorithm algorithm, uint32_t seed,
+                       ThreadPool* pool = nullptr);
@@ -0,0 +1,50 @@
+#include "wilson-strategy.hpp"
+
+#include "utils/random.hpp"
+
+void WilsonStrategy::start(MazeGrid& grid, std::mt19937& rng) {
+  exit_dir.assign(grid.getCellCount(), 0);
+  cursor = 0;
+  walk_start = MazeGrid::NO_CELL;
+
+  // the maze starts out as a single random cell
+  current = helper::getRandomIndex(rng, grid.getCellCount());
+  grid.setVisited(current);
+}
+
+bool WilsonStrategy::step(MazeGrid& grid, std::mt19937& rng) {
+  if (walk_start == MazeGrid::NO_CELL) {
+    // start the next walk from the first cell not in the maze yet
+    while (cursor < grid.getCellCount() && grid.isVisited(cursor)) cursor++;
+    if (cursor == grid.getCellCount()) {
+      current = MazeGrid::NO_CELL;
+      return false;
+    }
+    walk_start = cursor;
+    current = cursor;
+  }
+
+  // move the walk to a random neighbour
+  int candidates[4];
+  int count = 0;
+  for (int dir = TOP; dir <= LEFT; ++dir) {
+    if (grid.getNeighbor(current, dir) != MazeGrid::NO_CELL) {
+      candidates[count++] = dir;
+    }
+  }
+  const int dir = candidates[helper::getRandomIndex(rng, count)];
+  exit_dir[current] = static_cast<uint8_t>(dir);
+  current = grid.getNeighbor(current, dir);
+
+  // the walk reached the maze: carve its loop-erased path into it
+  if (grid.isVisited(current)) {
+    int cell = walk_start;
+    while (!grid.isVisited(cell)) {
+      grid.setVisited(cell);
+      grid.removeWall(cell, exit_dir[cell]);
+      cell = grid.getNeighbor(cell, exit_dir[cell]);
+    }
+    walk_start = MazeGrid::NO_CELL;
+  }
+  return true;
+}
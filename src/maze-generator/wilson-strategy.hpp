@@ -0,0 +1,25 @@
+/*
+Wilson's algorithm
+
+Adds loop-erased random walks to the maze until every cell is part of it, which samples uniformly
+among all perfect mazes (no directional bias). Each step advances the walk by one cell; loops are
+erased implicitly because a cell only remembers the direction of its last exit.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "generation-strategy.hpp"
+
+class WilsonStrategy : public GenerationStrategy {
+  std::vector<uint8_t> exit_dir;     // direction the walk last left each cell in
+  int cursor = 0;                    // next cell to check for a new walk start
+  int walk_start = MazeGrid::NO_CELL;  // first cell of the current walk
+  int current = MazeGrid::NO_CELL;   // head of the current walk
+
+ public:
+  void start(MazeGrid& grid, std::mt19937& rng) override;
+  bool step(MazeGrid& grid, std::mt19937& rng) override;
+  int getCurrentCell() const override { return current; }
+};
@@ -0,0 +1,156 @@
+#include "ambient-occlusion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr float ORIGIN_OFFSET = 1e-3f;  // rays start this far off the surface
+
+// Ray of the hemisphere with the reciprocal of its direction, for the slab test
+struct AoRay {
+  float direction[3];
+  float inverse[3];  // 1 / direction, infinite along the axes it does not move on
+};
+
+// Cosine-distributed rays over the hemisphere of each axis-aligned normal, on a Fibonacci spiral;
+// normal n is the axis n / 2, positive for even n
+std::array<std::array<AoRay, AO_RAYS>, 6> makeHemispheres() {
+  const float GOLDEN_ANGLE = 2.39996323f;
+  std::array<std::array<AoRay, AO_RAYS>, 6> hemispheres;
+  for (int normal = 0; normal < 6; ++normal) {
+    const int axis = normal / 2;
+    const float sign = normal % 2 == 0 ? 1.0f : -1.0f;
+    for (int i = 0; i < AO_RAYS; ++i) {
+      const float radius = std::sqrt((i + 0.5f) / AO_RAYS);
+      const float angle = i * GOLDEN_ANGLE;
+      AoRay& ray = hemispheres[normal][i];
+      ray.direction[axis] = sign * std::sqrt(1.0f - radius * radius);
+      ray.direction[(axis + 1) % 3] = radius * std::cos(angle);
+      ray.direction[(axis + 2) % 3] = radius * std::sin(angle);
+      for (int k = 0; k < 3; ++k) ray.inverse[k] = 1.0f / ray.direction[k];
+    }
+  }
+  return hemispheres;
+}
+
+const std::array<std::array<AoRay, AO_RAYS>, 6> HEMISPHERES = makeHemispheres();
+
+// Whether a ray hits a box within the radius; a ray starting on the box surface hits it
+bool rayHitsBox(const float origin[3], const AoRay& ray, const AABB& box) {
+  const float min[3] = {box.min.x, box.min.y, box.min.z};
+  const float max[3] = {box.max.x, box.max.y, box.max.z};
+  float enter = 0.0f;
+  float exit = AO_RADIUS;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (ray.direction[axis] == 0.0f) {
+      if (origin[axis] < min[axis] || origin[axis] > max[axis]) return false;
+      continue;
+    }
+    float near = (min[axis] - origin[axis]) * ray.inverse[axis];
+    float far = (max[axis] - origin[axis]) * ray.inverse[axis];
+    if (near > far) std::swap(near, far);
+    enter = std::max(enter, near);
+    exit = std::min(exit, far);
+    if (enter > exit) return false;
+  }
+  return true;
+}
+
+// Light reaching a point of a surface, from AO_MIN_LIGHT (fully occluded) to 1
+float bakePoint(const float position[3], const float normal[3], float floor_top,
+                const CollisionGrid& walls, std::vector<AABB>& nearby) {
+  int normal_index = 0;
+  while (normal[normal_index / 2] * (normal_index % 2 == 0 ? 1.0f : -1.0f) < 0.5f) {
+    normal_index++;
+  }
+  const int normal_axis = normal_index / 2;
+  const float origin[3] = {position[0] + normal[0] * ORIGIN_OFFSET,
+                           position[1] + normal[1] * ORIGIN_OFFSET,
+                           position[2] + normal[2] * ORIGIN_OFFSET};
+
+  const AABB reach = {{origin[0] - AO_RADIUS, origin[1] - AO_RADIUS, origin[2] - AO_RADIUS},
+                      {origin[0] + AO_RADIUS, origin[1] + AO_RADIUS, origin[2] + AO_RADIUS}};
+  nearby.clear();
+  bool buried = false;
+  walls.forEachNear(reach, [&](const AABB& wall_bbox) {
+    const float min[3] = {wall_bbox.min.x, wall_bbox.min.y, wall_bbox.min.z};
+    const float max[3] = {wall_bbox.max.x, wall_bbox.max.y, wall_bbox.max.z};
+    buried = origin[0] > min[0] && origin[0] < max[0] && origin[1] > min[1] &&
+             origin[1] < max[1] && origin[2] > min[2] && origin[2] < max[2];
+    // boxes wholly behind the surface are out of every ray's way
+    const bool behind = normal[normal_axis] > 0.0f ? max[normal_axis] < origin[normal_axis]
+                                                   : min[normal_axis] > origin[normal_axis];
+    if (!behind) nearby.push_back(wall_bbox);
+    return buried;
+  });
+  if (buried) return AO_MIN_LIGHT;
+
+  int blocked = 0;
+  for (const AoRay& ray : HEMISPHERES[normal_index]) {
+    // the floor is a plane under the whole maze
+    bool hit = ray.direction[1] < 0.0f && (floor_top - origin[1]) * ray.inverse[1] <= AO_RADIUS;
+    for (std::size_t i = 0; !hit && i < nearby.size(); ++i) {
+      hit = rayHitsBox(origin, ray, nearby[i]);
+    }
+    blocked += hit;
+  }
+  const float open = 1.0f - static_cast<float>(blocked) / AO_RAYS;
+  return AO_MIN_LIGHT + (1.0f - AO_MIN_LIGHT) * open;
+}
+
+// Bake the corners of every face (appendBox() writes four vertices per face). A corner is
+// sampled inside its face, up to `inset` from it along both face axes and no lower than the
+// floor, since the corners themselves sit in the wall posts at the cell corners or under the
+// floor at the wall feet.
+void bakeMesh(MeshData& mesh, float floor_top, float inset, const CollisionGrid& walls,
+              std::vector<AABB>& nearby) {
+  for (int face = 0; face + 4 <= mesh.getVertexCount(); face += 4) {
+    const float* corners = &mesh.vertices[face * 3];
+    float center[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 4 * 3; ++i) center[i % 3] += corners[i] / 4;
+
+    for (int vertex = face; vertex < face + 4; ++vertex) {
+      const float* position = &mesh.vertices[vertex * 3];
+      float sample[3];
+      for (int axis = 0; axis < 3; ++axis) {
+        sample[axis] = position[axis] + std::clamp(center[axis] - position[axis], -inset, inset);
+      }
+      sample[1] = std::max(sample[1], floor_top);
+
+      const float light = bakePoint(sample, &mesh.normals[vertex * 3], floor_top, walls, nearby);
+      const uint8_t value = static_cast<uint8_t>(std::lround(light * 255.0f));
+      uint8_t* color = &mesh.colors[vertex * 4];
+      color[0] = value;
+      color[1] = value;
+      color[2] = value;
+    }
+  }
+}
+
+}  // namespace
+
+void bakeAmbientOcclusion(MazeGeometry& geometry, const MazeGenerator& maze, ThreadPool* pool) {
+  std::vector<MeshChunk>& chunks = geometry.getChunks();
+  const float floor_top = maze.getFloorDimension().height / 2;
+  // far enough from a corner to clear the wall post there
+  const float inset = maze.getWallDepth();
+  const CollisionGrid& walls = maze.getWallIndex();
+
+  auto bakeChunks = [&](int begin, int end) {
+    std::vector<AABB> nearby;
+    for (int i = begin; i < end; ++i) {
+      bakeMesh(chunks[i].floor, floor_top, inset, walls, nearby);
+      bakeMesh(chunks[i].walls, floor_top, inset, walls, nearby);
+    }
+  };
+  const int count = static_cast<int>(chunks.size());
+  if (pool && pool->getThreadCount() > 0) {
+    pool->parallelFor(count, bakeChunks);
+  } else {
+    bakeChunks(0, count);
+  }
+}
@@ -0,0 +1,24 @@
+/*
+Ambient Occlusion - Occlusion baked into the vertex colors of the maze meshes
+
+Once the meshes are built, every face corner casts a fixed set of cosine-distributed rays over
+the hemisphere of its normal against the nearby wall boxes and the floor, and is darkened by the
+share of rays blocked within a short radius. Corners, the foot of the walls and dead ends come
+out darker, on the existing box corners only: the meshes keep their triangle count and the
+default shader multiplies the vertex color into the texture, so drawing costs nothing more. The
+chunks are baked in parallel.
+*/
+#pragma once
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/maze-generator.hpp"
+#include "maze-geometry.hpp"
+
+constexpr int AO_RAYS = 32;            // rays cast per vertex
+constexpr float AO_RADIUS = 1.2f;      // farthest distance at which a box occludes
+constexpr float AO_MIN_LIGHT = 0.35f;  // light left on a fully occluded vertex
+
+// Bake the occlusion of a completed maze (after calcBoundingBoxes()) into the vertex colors of
+// its geometry, spread over the pool (nullptr: on the calling thread)
+void bakeAmbientOcclusion(MazeGeometry& geometry, const MazeGenerator& maze,
+                          ThreadPool* pool = nullptr);
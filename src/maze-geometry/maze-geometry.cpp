@@ -0,0 +1,220 @@
+#include "maze-geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Corner of a box face with its texture coordinate
+struct FaceVertex {
+  bool max_x;
+  bool max_y;
+  bool max_z;
+  float u;
+  float v;
+};
+
+// Face layout, same vertex order and texture mapping as neuro_path_texture::DrawCubeTexture
+struct FaceLayout {
+  BoxFace face;
+  float normal[3];
+  int u_axis;  // axis the u coordinate runs along (0 = x, 1 = y, 2 = z)
+  int v_axis;  // axis the v coordinate runs along
+  FaceVertex corners[4];
+};
+
+const FaceLayout FACE_LAYOUTS[] = {
+    {FACE_FRONT,
+     {0.0f, 0.0f, 1.0f},
+     0,
+     1,
+     {{false, false, true, 0.0f, 0.0f},
+      {true, false, true, 1.0f, 0.0f},
+      {true, true, true, 1.0f, 1.0f},
+      {false, true, true, 0.0f, 1.0f}}},
+    {FACE_BACK,
+     {0.0f, 0.0f, -1.0f},
+     0,
+     1,
+     {{false, false, false, 1.0f, 0.0f},
+      {false, true, false, 1.0f, 1.0f},
+      {true, true, false, 0.0f, 1.0f},
+      {true, false, false, 0.0f, 0.0f}}},
+    {FACE_TOP,
+     {0.0f, 1.0f, 0.0f},
+     0,
+     2,
+     {{false, true, false, 0.0f, 1.0f},
+      {false, true, true, 0.0f, 0.0f},
+      {true, true, true, 1.0f, 0.0f},
+      {true, true, false, 1.0f, 1.0f}}},
+    {FACE_BOTTOM,
+     {0.0f, -1.0f, 0.0f},
+     0,
+     2,
+     {{false, false, false, 1.0f, 1.0f},
+      {true, false, false, 0.0f, 1.0f},
+      {true, false, true, 0.0f, 0.0f},
+      {false, false, true, 1.0f, 0.0f}}},
+    {FACE_RIGHT,
+     {1.0f, 0.0f, 0.0f},
+     2,
+     1,
+     {{true, false, false, 1.0f, 0.0f},
+      {true, true, false, 1.0f, 1.0f},
+      {true, true, true, 0.0f, 1.0f},
+      {true, false, true, 0.0f, 0.0f}}},
+    {FACE_LEFT,
+     {-1.0f, 0.0f, 0.0f},
+     2,
+     1,
+     {{false, false, false, 0.0f, 0.0f},
+      {false, false, true, 1.0f, 0.0f},
+      {false, true, true, 1.0f, 1.0f},
+      {false, true, false, 0.0f, 1.0f}}},
+};
+
+// Grow a bounding box to contain another one
+void expand(AABB& bounds, const AABB& box) {
+  bounds.min = {std::min(bounds.min.x, box.min.x), std::min(bounds.min.y, box.min.y),
+                std::min(bounds.min.z, box.min.z)};
+  bounds.max = {std::max(bounds.max.x, box.max.x), std::max(bounds.max.y, box.max.y),
+                std::max(bounds.max.z, box.max.z)};
+}
+
+// Get a coordinate of a point by axis index
+float axisValue(const Vec3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+// Number of texture repeats across a box along an axis
+float textureRepeat(const AABB& box, const Vec3& texture_size, int axis) {
+  const float size = axisValue(texture_size, axis);
+  if (size <= 0.0f) return 1.0f;
+  return (axisValue(box.max, axis) - axisValue(box.min, axis)) / size;
+}
+}  // namespace
+
+void appendBox(MeshData& mesh, const AABB& box, uint8_t faces, const Vec3& texture_size) {
+  for (const FaceLayout& layout : FACE_LAYOUTS) {
+    if (!(faces & layout.face)) continue;
+
+    const float u_repeat = textureRepeat(box, texture_size, layout.u_axis);
+    const float v_repeat = textureRepeat(box, texture_size, layout.v_axis);
+
+    // each quad becomes two triangles (0, 1, 2) and (0, 2, 3), like RL_QUADS does
+    const uint16_t base = static_cast<uint16_t>(mesh.getVertexCount());
+    for (const FaceVertex& corner : layout.corners) {
+      mesh.vertices.push_back(corner.max_x ? box.max.x : box.min.x);
+      mesh.vertices.push_back(corner.max_y ? box.max.y : box.min.y);
+      mesh.vertices.push_back(corner.max_z ? box.max.z : box.min.z);
+      mesh.texcoords.push_back(corner.u * u_repeat);
+      mesh.texcoords.push_back(corner.v * v_repeat);
+      mesh.normals.insert(mesh.normals.end(), layout.normal, layout.normal + 3);
+      mesh.colors.insert(mesh.colors.end(), {255, 255, 255, 255});
+    }
+    mesh.indices.insert(mesh.indices.end(),
+                        {base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2),
+                         base, static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3)});
+  }
+}
+
+MeshChunk& MazeGeometry::chunkFor(int cell_x, int cell_z, const AABB& box) {
+  const int chunk_x = std::clamp(cell_x / CHUNK_SIZE, 0, chunks_x - 1);
+  const int chunk_z = std::clamp(cell_z / CHUNK_SIZE, 0, chunks_z - 1);
+
+  MeshChunk& chunk = chunks[chunk_z * chunks_x + chunk_x];
+  if (chunk.floor.empty() && chunk.walls.empty()) {
+    chunk.bounds = box;
+  } else {
+    expand(chunk.bounds, box);
+  }
+  return chunk;
+}
+
+void MazeGeometry::appendWallRun(const MazeGenerator& maze, const WallRun& run, const AABB& box) {
+  const MazeGrid& grid = maze.getGrid();
+  const BoxSize3D& cell = maze.getFloorDimension();
+  // one texture repeat per cell along the wall, and once over the wall height
+  const Vec3 texture_size = {cell.width, maze.getWallHeight(), cell.depth};
+
+  // an end cap is buried when the perpendicular walls on both sides of its corner stand
+  bool start_cap;
+  bool end_cap;
+  if (run.horizontal) {
+    start_cap = !(grid.hasVerticalWall(run.start, run.line - 1) &&
+                  grid.hasVerticalWall(run.start, run.line));
+    end_cap = !(grid.hasVerticalWall(run.end + 1, run.line - 1) &&
+                grid.hasVerticalWall(run.end + 1, run.line));
+  } else {
+    start_cap = !(grid.hasHorizontalWall(run.line - 1, run.start) &&
+                  grid.hasHorizontalWall(run.line, run.start));
+    end_cap = !(grid.hasHorizontalWall(run.line - 1, run.end + 1) &&
+                grid.hasHorizontalWall(run.line, run.end + 1));
+  }
+  const uint8_t start_face = run.horizontal ? FACE_LEFT : FACE_BACK;
+  const uint8_t end_face = run.horizontal ? FACE_RIGHT : FACE_FRONT;
+
+  // split the run at chunk borders; the pieces touch, so their inner caps are hidden too
+  for (int start = run.start; start <= run.end;) {
+    const int end = std::min(run.end, (start / CHUNK_SIZE + 1) * CHUNK_SIZE - 1);
+
+    AABB piece = box;
+    uint8_t faces = FACE_ALL & ~FACE_BOTTOM & ~start_face & ~end_face;
+    if (start == run.start && start_cap) faces |= start_face;
+    if (end == run.end && end_cap) faces |= end_face;
+
+    int cell_x;
+    int cell_z;
+    if (run.horizontal) {
+      piece.min.x = start * cell.width - cell.width / 2;
+      piece.max.x = end * cell.width + cell.width / 2;
+      cell_x = start;
+      cell_z = std::min(run.line, grid.getRows() - 1);
+    } else {
+      piece.min.z = start * cell.depth - cell.depth / 2;
+      piece.max.z = end * cell.depth + cell.depth / 2;
+      cell_x = std::min(run.line, grid.getCols() - 1);
+      cell_z = start;
+    }
+    appendBox(chunkFor(cell_x, cell_z, piece).walls, piece, faces, texture_size);
+
+    start = end + 1;
+  }
+}
+
+void MazeGeometry::build(const MazeGenerator& maze) {
+  const MazeGrid& grid = maze.getGrid();
+  const int cols = grid.getCols();
+  const int rows = grid.getRows();
+
+  chunks_x = (cols + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  chunks_z = (rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  chunks.assign(static_cast<std::size_t>(chunks_x) * chunks_z, MeshChunk{});
+  for (int z = 0; z < chunks_z; ++z) {
+    for (int x = 0; x < chunks_x; ++x) {
+      chunks[z * chunks_x + x].chunk_x = x;
+      chunks[z * chunks_x + x].chunk_z = z;
+    }
+  }
+
+  // floor tiles: only the top is visible, plus the sides along the border of the maze (unless
+  // the floor continues into a neighbouring maze)
+  const std::vector<AABB>& floor_bboxes = maze.getFloorBBoxes();
+  const bool border_sides = !maze.hasSharedBorders();
+  for (int cell = 0; cell < grid.getCellCount(); ++cell) {
+    const int x = grid.cellX(cell);
+    const int z = grid.cellY(cell);
+    uint8_t faces = FACE_TOP;
+    if (border_sides) {
+      if (x == 0) faces |= FACE_LEFT;
+      if (x == cols - 1) faces |= FACE_RIGHT;
+      if (z == 0) faces |= FACE_BACK;
+      if (z == rows - 1) faces |= FACE_FRONT;
+    }
+    appendBox(chunkFor(x, z, floor_bboxes[cell]).floor, floor_bboxes[cell], faces);
+  }
+
+  const std::vector<WallRun>& wall_runs = maze.getWallRuns();
+  const std::vector<AABB>& wall_bboxes = maze.getWallBBoxes();
+  for (std::size_t i = 0; i < wall_runs.size(); ++i) {
+    appendWallRun(maze, wall_runs[i], wall_bboxes[i]);
+  }
+}
@@ -0,0 +1,80 @@
+/*
+Maze Geometry - Static mesh builder
+
+Turns the floor and wall bounding boxes of a completed maze into textured triangle meshes, once,
+so the renderer can upload them to the GPU and draw the whole maze with a few draw calls. The
+meshes are split into square chunks of cells to keep every mesh within 16-bit indices.
+
+Faces that can never be seen are left out: the bottom of every box, the sides of floor tiles
+inside the maze, and wall end caps buried in a perpendicular wall.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "maze-generator/maze-generator.hpp"
+#include "utils/types.hpp"
+
+// Faces of a box, usable as a bit mask
+enum BoxFace : uint8_t {
+  FACE_FRONT = 1 << 0,   // +z
+  FACE_BACK = 1 << 1,    // -z
+  FACE_TOP = 1 << 2,     // +y
+  FACE_BOTTOM = 1 << 3,  // -y
+  FACE_RIGHT = 1 << 4,   // +x
+  FACE_LEFT = 1 << 5,    // -x
+  FACE_ALL = 0x3F
+};
+
+// Vertex data of one mesh, laid out the way raylib's Mesh expects it
+struct MeshData {
+  std::vector<float> vertices;    // x, y, z per vertex
+  std::vector<float> texcoords;   // u, v per vertex
+  std::vector<float> normals;     // x, y, z per vertex
+  std::vector<uint8_t> colors;    // r, g, b, a per vertex
+  std::vector<uint16_t> indices;  // three per triangle
+
+  int getVertexCount() const { return static_cast<int>(vertices.size() / 3); }
+  int getTriangleCount() const { return static_cast<int>(indices.size() / 3); }
+  bool empty() const { return indices.empty(); }
+};
+
+// Geometry of a square block of cells
+struct MeshChunk {
+  int chunk_x;     // chunk column
+  int chunk_z;     // chunk row
+  AABB bounds;     // bounds of all the geometry in the chunk
+  MeshData floor;  // floor tiles (floor texture)
+  MeshData walls;  // walls (wall texture)
+};
+
+// MazeGeometry class building the static meshes of a maze
+class MazeGeometry {
+ public:
+  static constexpr int CHUNK_SIZE = 16;  // cells per chunk side
+
+ private:
+  int chunks_x = 0;               // number of chunk columns
+  int chunks_z = 0;               // number of chunk rows
+  std::vector<MeshChunk> chunks;  // chunks, row by row
+
+  // Get the chunk containing a cell and grow its bounds by a box
+  MeshChunk& chunkFor(int cell_x, int cell_z, const AABB& box);
+  // Append the pieces of a wall run, split at chunk borders
+  void appendWallRun(const MazeGenerator& maze, const WallRun& run, const AABB& box);
+
+ public:
+  // Build the meshes from the bounding boxes of a completed maze
+  void build(const MazeGenerator& maze);
+
+  int getChunksX() const { return chunks_x; }
+  int getChunksZ() const { return chunks_z; }
+  const std::vector<MeshChunk>& getChunks() const { return chunks; }
+  std::vector<MeshChunk>& getChunks() { return chunks; }
+};
+
+// Append the selected faces of a box. texture_size is the world size of one texture repeat
+// along each axis; 0 maps the texture once per face.
+void appendBox(MeshData& mesh, const AABB& box, uint8_t faces = FACE_ALL,
+               const Vec3& texture_size = {0.0f, 0.0f, 0.0f});
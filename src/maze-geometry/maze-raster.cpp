@@ -0,0 +1,98 @@
+#include "maze-raster.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// RGBA8 colors, red in the lowest byte
+constexpr uint32_t rgba(uint32_t r, uint32_t g, uint32_t b) {
+  return r | (g << 8) | (b << 16) | (0xFFu << 24);
+}
+constexpr uint32_t BACKGROUND = rgba(245, 245, 245);  // raylib RAYWHITE, the 2D background
+constexpr uint32_t VISITED = rgba(222, 222, 222);     // half transparent LIGHTGRAY over it
+constexpr uint32_t WALL = rgba(0, 0, 0);
+
+// Blend two colors channel by channel, t in [0, 256]
+uint32_t mix(uint32_t a, uint32_t b, uint32_t t) {
+  uint32_t result = 0xFFu << 24;
+  for (int shift = 0; shift < 24; shift += 8) {
+    const uint32_t ca = (a >> shift) & 0xFF;
+    const uint32_t cb = (b >> shift) & 0xFF;
+    result |= ((ca * (256 - t) + cb * t) >> 8) << shift;
+  }
+  return result;
+}
+
+}  // namespace
+
+RasterExtent MazeRasterizer::rasterize(const MazeGrid& grid, int level, int tile_x, int tile_y,
+                                       bool show_visited, std::vector<uint32_t>& pixels) {
+  const int cells = getTileCells(level);
+  const int x0 = tile_x * cells;
+  const int y0 = tile_y * cells;
+  const int x1 = std::min(x0 + cells, grid.getCols());
+  const int y1 = std::min(y0 + cells, grid.getRows());
+  const int last_col = grid.getCols() - 1;
+  const int last_row = grid.getRows() - 1;
+
+  pixels.assign(static_cast<std::size_t>(TILE_TEXELS) * TILE_TEXELS, BACKGROUND);
+  const int texels_per_cell = TILE_TEXELS / cells;  // 0 once a texel covers several cells
+
+  if (texels_per_cell >= 2) {
+    // every wall is a line along the top or left edge of its cell; the maze's bottom and right
+    // borders are drawn along the inner edge of the last cells
+    const int s = texels_per_cell;
+    for (int cy = y0; cy < y1; ++cy) {
+      for (int cx = x0; cx < x1; ++cx) {
+        const int cell = grid.cellId(cx, cy);
+        uint32_t* origin = pixels.data() + static_cast<std::size_t>(cy - y0) * s * TILE_TEXELS +
+                           (cx - x0) * s;
+        if (show_visited && grid.isVisited(cell)) {
+          for (int y = 0; y < s; ++y) std::fill_n(origin + y * TILE_TEXELS, s, VISITED);
+        }
+
+        const uint8_t walls = grid.getWalls(cell);
+        if (walls & wallBit(TOP)) std::fill_n(origin, s, WALL);
+        if ((walls & wallBit(BOTTOM)) && cy == last_row) {
+          std::fill_n(origin + (s - 1) * TILE_TEXELS, s, WALL);
+        }
+        if (walls & wallBit(LEFT)) {
+          for (int y = 0; y < s; ++y) origin[y * TILE_TEXELS] = WALL;
+        }
+        if ((walls & wallBit(RIGHT)) && cx == last_col) {
+          for (int y = 0; y < s; ++y) origin[y * TILE_TEXELS + s - 1] = WALL;
+        }
+      }
+    }
+    return {(x1 - x0) * s, (y1 - y0) * s};
+  }
+
+  // several cells per texel: count the walls and visited cells each texel covers
+  const int cells_per_texel = cells / TILE_TEXELS;
+  const int used_width = (x1 - x0 + cells_per_texel - 1) / cells_per_texel;
+  const int used_height = (y1 - y0 + cells_per_texel - 1) / cells_per_texel;
+  wall_counts.assign(pixels.size(), 0);
+  visited_counts.assign(pixels.size(), 0);
+  for (int cy = y0; cy < y1; ++cy) {
+    const std::size_t row = static_cast<std::size_t>((cy - y0) / cells_per_texel) * TILE_TEXELS;
+    for (int cx = x0; cx < x1; ++cx) {
+      const int cell = grid.cellId(cx, cy);
+      const std::size_t texel = row + (cx - x0) / cells_per_texel;
+      const uint8_t walls = grid.getWalls(cell);
+      wall_counts[texel] += ((walls >> TOP) & 1) + ((walls >> LEFT) & 1);
+      if (show_visited) visited_counts[texel] += grid.isVisited(cell);
+    }
+  }
+
+  // a perfect maze keeps about half of its walls: that shows as a mid grey, a solid block of
+  // uncarved cells as black
+  const uint32_t texel_cells = static_cast<uint32_t>(cells_per_texel) * cells_per_texel;
+  for (int ty = 0; ty < used_height; ++ty) {
+    for (int tx = 0; tx < used_width; ++tx) {
+      const std::size_t texel = static_cast<std::size_t>(ty) * TILE_TEXELS + tx;
+      const uint32_t base = mix(BACKGROUND, VISITED, visited_counts[texel] * 256 / texel_cells);
+      pixels[texel] = mix(base, WALL, std::min(256u, wall_counts[texel] * 128 / texel_cells));
+    }
+  }
+  return {used_width, used_height};
+}
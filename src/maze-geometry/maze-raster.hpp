@@ -0,0 +1,41 @@
+/*
+Maze Raster - CPU rasterization of 2D maze tiles
+
+Draws the walls (and the cells visited so far) of a square tile of the grid into an RGBA8 pixel
+buffer, for the 2D view to upload as a texture. Level 0 tiles cover 16x16 cells at 16 texels per
+cell; every level up covers twice as many cells per side in the same 256x256 texels. Where a
+texel covers less than two cells it shows each wall as a line; where it covers more, it shows
+the share of walls (and of visited cells) it covers as a shade, like a mipmap would.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "maze-generator/maze-grid.hpp"
+
+// Texels of a tile rasterized from the cells it covers
+struct RasterExtent {
+  int width;   // texels used horizontally (less than TILE_TEXELS on the last column of tiles)
+  int height;  // texels used vertically
+};
+
+// MazeRasterizer class drawing maze tiles into pixel buffers
+class MazeRasterizer {
+ public:
+  static constexpr int TILE_TEXELS = 256;    // texels per side of every tile
+  static constexpr int BASE_TILE_CELLS = 16;  // cells per side of a level 0 tile
+
+ private:
+  std::vector<uint32_t> wall_counts;     // walls per texel, when texels cover several cells
+  std::vector<uint32_t> visited_counts;  // visited cells per texel
+
+ public:
+  // Cells per side of a tile at a level
+  static int getTileCells(int level) { return BASE_TILE_CELLS << level; }
+
+  // Draw tile (tile_x, tile_y) of a level into pixels (TILE_TEXELS * TILE_TEXELS RGBA8 values,
+  // row-major); visited cells are shaded when show_visited is set
+  RasterExtent rasterize(const MazeGrid& grid, int level, int tile_x, int tile_y,
+                         bool show_visited, std::vector<uint32_t>& pixels);
+};
@@ -0,0 +1,130 @@
+#include "maze-pack-writer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "maze-generator/fixed-maze.hpp"
+#include "solver/maze-difficulty.hpp"
+#include "solver/maze-solver.hpp"
+
+namespace {
+
+constexpr std::size_t BATCH_BYTES = std::size_t{64} << 20;  // walls generated before writing
+constexpr std::size_t BATCH_MAZES = 4096;                   // mazes generated before writing
+
+// Round an offset up to the alignment of the index entries
+uint64_t alignOffset(uint64_t offset) {
+  const uint64_t alignment = alignof(MazePackEntry);
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+std::size_t getWallBytes(const MazePackRequest& request) {
+  return (static_cast<std::size_t>(request.cols) * request.rows + 1) / 2;
+}
+
+// Write zero bytes up to an offset
+bool padTo(std::FILE* file, uint64_t& offset, uint64_t target) {
+  static const uint8_t zeros[alignof(MazePackEntry)] = {};
+  const std::size_t count = static_cast<std::size_t>(target - offset);
+  offset = target;
+  return std::fwrite(zeros, 1, count, file) == count;
+}
+
+}  // namespace
+
+void computeMazePackStats(const MazeGrid& grid, MazePackEntry& entry) {
+  std::vector<int> path;
+  MazeSolver solver(grid);
+  solver.solve(0, grid.getCellCount() - 1, path, SolverAlgorithm::BFS);
+  const MazeMetrics metrics = analyzeMaze(grid, path);
+  entry.solution_length = static_cast<uint32_t>(metrics.solution_length);
+  entry.solution_turns = static_cast<uint32_t>(metrics.turns);
+  entry.dead_ends = static_cast<uint32_t>(metrics.dead_ends);
+  entry.junctions = static_cast<uint32_t>(metrics.junctions);
+}
+
+bool writeMazePack(const std::string& file_name, const std::vector<MazePackRequest>& requests,
+                   ThreadPool* pool) {
+  for (const MazePackRequest& request : requests) {
+    if (request.cols < 1 || request.cols > UINT16_MAX || request.rows < 1 ||
+        request.rows > UINT16_MAX) {
+      return false;
+    }
+  }
+  std::FILE* file = std::fopen(file_name.c_str(), "wb");
+  if (!file) return false;
+
+  // header first, rewritten once the index offset is known
+  MazePackHeader header = {};
+  header.magic = MAZE_PACK_MAGIC;
+  header.version = MAZE_PACK_VERSION;
+  header.maze_count = static_cast<uint32_t>(requests.size());
+  header.entry_size = sizeof(MazePackEntry);
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+  uint64_t offset = sizeof(header);
+
+  std::vector<MazePackEntry> entries(requests.size());
+  std::vector<std::vector<uint8_t>> walls;
+  std::size_t begin = 0;
+  while (ok && begin < requests.size()) {
+    // a batch of mazes is generated in parallel, then written in order
+    std::size_t end = begin;
+    std::size_t batch_bytes = 0;
+    while (end < requests.size() && end - begin < BATCH_MAZES && batch_bytes < BATCH_BYTES) {
+      batch_bytes += getWallBytes(requests[end++]);
+    }
+    walls.resize(end - begin);
+
+    auto generate = [&](int first, int last) {
+      for (int i = first; i < last; ++i) {
+        const MazePackRequest& request = requests[begin + i];
+        MazeGrid grid(request.cols, request.rows);
+        walls[i].resize(grid.getPackedWallsSize());
+        // standard mazes are carved without the heap; the grid only serves the stats
+        if (generateFixedWalls(request.cols, request.rows, request.algorithm, request.seed,
+                               walls[i].data())) {
+          grid.unpackWalls(walls[i].data());
+        } else {
+          generateSeededMaze(grid, request.algorithm, request.seed);
+          grid.packWalls(walls[i].data());
+        }
+
+        MazePackEntry& entry = entries[begin + i];
+        entry.seed = request.seed;
+        entry.cols = static_cast<uint16_t>(request.cols);
+        entry.rows = static_cast<uint16_t>(request.rows);
+        entry.algorithm = static_cast<uint8_t>(request.algorithm);
+        computeMazePackStats(grid, entry);
+      }
+    };
+    const int count = static_cast<int>(end - begin);
+    if (pool && pool->getThreadCount() > 0) {
+      pool->parallelFor(count, generate);
+    } else {
+      generate(0, count);
+    }
+
+    for (std::size_t i = begin; ok && i < end; ++i) {
+      ok = padTo(file, offset, alignOffset(offset));
+      entries[i].walls_offset = offset;
+      const std::vector<uint8_t>& maze_walls = walls[i - begin];
+      ok = ok && std::fwrite(maze_walls.data(), 1, maze_walls.size(), file) == maze_walls.size();
+      offset += maze_walls.size();
+    }
+    begin = end;
+  }
+
+  // the index comes last, so the walls are written as they are generated
+  ok = ok && padTo(file, offset, alignOffset(offset));
+  header.index_offset = offset;
+  if (!entries.empty()) {
+    ok = ok && std::fwrite(entries.data(), sizeof(MazePackEntry), entries.size(), file) ==
+                   entries.size();
+  }
+  header.file_size = offset + entries.size() * sizeof(MazePackEntry);
+  ok = ok && std::fseek(file, 0, SEEK_SET) == 0 &&
+       std::fwrite(&header, sizeof(header), 1, file) == 1;
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok) std::remove(file_name.c_str());
+  return ok;
+}
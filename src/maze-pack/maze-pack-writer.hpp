@@ -0,0 +1,34 @@
+/*
+Maze Pack Writer - Batch generation of a maze pack
+
+Generates mazes from explicit seeds on a thread pool and writes them, with their solution and
+difficulty stats, into a pack file (see maze-pack.hpp). Every maze has the same walls as a
+MazeGenerator given the same size, algorithm and seed, so a pack can be regenerated or extended
+at any time. Mazes are generated and written in batches, so memory stays bounded for any count.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/generation-strategy.hpp"
+#include "maze-generator/maze-grid.hpp"
+#include "maze-pack.hpp"
+
+// Maze to put into a pack
+struct MazePackRequest {
+  uint32_t seed;
+  GenerationAlgorithm algorithm;
+  int cols;  // 1..65535
+  int rows;  // 1..65535
+};
+
+// Fill the solution and difficulty stats of an index entry from a carved grid
+void computeMazePackStats(const MazeGrid& grid, MazePackEntry& entry);
+
+// Generate the mazes on the pool (nullptr: on the calling thread) and write them as a pack, in
+// the order requested; false if the file cannot be written or a size is out of range
+bool writeMazePack(const std::string& file_name, const std::vector<MazePackRequest>& requests,
+                   ThreadPool* pool = nullptr);
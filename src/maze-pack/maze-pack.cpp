@@ -0,0 +1,99 @@
+#include "maze-pack.hpp"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MazePack::open(const std::string& file_name) {
+  close();
+
+#if defined(_WIN32)
+  file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    file_handle = nullptr;
+    return false;
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0) {
+    close();
+    return false;
+  }
+  mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping_handle) {
+    close();
+    return false;
+  }
+  data = static_cast<const uint8_t*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+  size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+  const int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+  void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED,
+                       fd, 0);
+  ::close(fd);  // the mapping keeps the file alive
+  if (mapping == MAP_FAILED) return false;
+  data = static_cast<const uint8_t*>(mapping);
+  size = static_cast<std::size_t>(info.st_size);
+#endif
+
+  if (!data || !validate()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool MazePack::validate() {
+  if (size < sizeof(MazePackHeader)) return false;
+  const MazePackHeader& header = *reinterpret_cast<const MazePackHeader*>(data);
+  // a big-endian reader sees the magic byte-swapped, so it is rejected here too
+  if (header.magic != MAZE_PACK_MAGIC || header.version != MAZE_PACK_VERSION ||
+      header.entry_size != sizeof(MazePackEntry) || header.file_size != size) {
+    return false;
+  }
+  if (header.index_offset % alignof(MazePackEntry) != 0 || header.index_offset > size ||
+      (size - header.index_offset) / sizeof(MazePackEntry) < header.maze_count ||
+      header.maze_count > static_cast<uint32_t>(INT32_MAX)) {
+    return false;
+  }
+
+  entries = reinterpret_cast<const MazePackEntry*>(data + header.index_offset);
+  for (uint32_t i = 0; i < header.maze_count; ++i) {
+    const MazePackEntry& entry = entries[i];
+    const std::size_t wall_bytes = (static_cast<std::size_t>(entry.cols) * entry.rows + 1) / 2;
+    if (entry.cols == 0 || entry.rows == 0 || entry.walls_offset > size ||
+        size - entry.walls_offset < wall_bytes) {
+      return false;
+    }
+  }
+  maze_count = static_cast<int>(header.maze_count);
+  return true;
+}
+
+void MazePack::close() {
+#if defined(_WIN32)
+  if (data) UnmapViewOfFile(data);
+  if (mapping_handle) CloseHandle(mapping_handle);
+  if (file_handle) CloseHandle(file_handle);
+  mapping_handle = nullptr;
+  file_handle = nullptr;
+#else
+  if (data) munmap(const_cast<uint8_t*>(data), size);
+#endif
+  data = nullptr;
+  size = 0;
+  entries = nullptr;
+  maze_count = 0;
+}
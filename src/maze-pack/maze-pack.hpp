@@ -0,0 +1,91 @@
+/*
+Maze Pack - Many pre-generated mazes in one memory-mapped file
+
+A pack is a fixed header, the walls of every maze as packed nibbles (laid out exactly like a
+row-major MazeGrid stores them) and an index with one entry per maze: seed, algorithm, size,
+solution and difficulty stats. Every field is little-endian and naturally aligned, so the file
+is used in place once mapped: opening a maze is an index lookup, with no parsing and no per-cell
+allocation.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "maze-generator/maze-grid.hpp"
+
+constexpr uint32_t MAZE_PACK_MAGIC = 0x4B50504E;  // "NPPK"
+constexpr uint32_t MAZE_PACK_VERSION = 1;
+
+// Header at the start of a pack
+struct MazePackHeader {
+  uint32_t magic;         // MAZE_PACK_MAGIC
+  uint32_t version;       // MAZE_PACK_VERSION
+  uint32_t maze_count;    // entries in the index
+  uint32_t entry_size;    // sizeof(MazePackEntry), to reject files with another layout
+  uint64_t index_offset;  // file offset of the index
+  uint64_t file_size;     // size of the whole file, to detect truncation
+};
+
+// Index entry of one maze
+struct MazePackEntry {
+  uint64_t walls_offset;     // file offset of the packed walls ((cols * rows + 1) / 2 bytes)
+  uint32_t seed;             // seed the maze was generated with
+  uint16_t cols;             // maze width in cells
+  uint16_t rows;             // maze height in cells
+  uint8_t algorithm;         // GenerationAlgorithm of the maze
+  uint8_t reserved[3];
+  uint32_t solution_length;  // cells on the path from the first cell to the last one
+  uint32_t solution_turns;   // changes of direction along that path
+  uint32_t dead_ends;        // cells with a single opening
+  uint32_t junctions;        // cells with three or four openings
+  uint32_t reserved2;
+};
+
+static_assert(sizeof(MazePackHeader) == 32, "MazePackHeader is part of the file format");
+static_assert(sizeof(MazePackEntry) == 40, "MazePackEntry is part of the file format");
+
+// Maze of a pack, pointing into the mapped file
+struct MazePackView {
+  const MazePackEntry* entry;  // index entry
+  const uint8_t* walls;        // packed walls, row-major, even cells in the low nibble
+
+  int getCellCount() const { return entry->cols * entry->rows; }
+  uint8_t getWalls(int cell) const { return (walls[cell >> 1] >> ((cell & 1) << 2)) & 0xF; }
+  bool hasWall(int cell, int dir) const { return (getWalls(cell) & wallBit(dir)) != 0; }
+};
+
+// MazePack class mapping a pack file into memory (read-only)
+class MazePack {
+  const uint8_t* data = nullptr;           // mapped file
+  std::size_t size = 0;                    // bytes mapped
+  const MazePackEntry* entries = nullptr;  // index inside the mapping
+  int maze_count = 0;                      // entries in the index
+#if defined(_WIN32)
+  void* file_handle = nullptr;  // file and mapping, kept open while mapped
+  void* mapping_handle = nullptr;
+#endif
+
+  // Check the header, the index and every wall range against the file size
+  bool validate();
+
+ public:
+  MazePack() = default;
+  ~MazePack() { close(); }
+
+  MazePack(const MazePack&) = delete;
+  MazePack& operator=(const MazePack&) = delete;
+
+  // Map a pack; false if it cannot be mapped or is not a valid pack
+  bool open(const std::string& file_name);
+  // Unmap the file; views into it become invalid
+  void close();
+  bool isOpen() const { return data != nullptr; }
+
+  int getMazeCount() const { return maze_count; }
+  const MazePackEntry& getEntry(int index) const { return entries[index]; }
+  MazePackView getMaze(int index) const {
+    return {&entries[index], data + entries[index].walls_offset};
+  }
+};
@@ -0,0 +1,82 @@
+#include "maze-mesh.hpp"
+
+#include <cstring>
+
+#include "raymath.h"
+
+// Copy a vector into a buffer owned by raylib (released by UnloadMesh)
+template <typename T>
+static T* copyToRaylib(const std::vector<T>& data) {
+  T* buffer = static_cast<T*>(MemAlloc(static_cast<unsigned int>(data.size() * sizeof(T))));
+  std::memcpy(buffer, data.data(), data.size() * sizeof(T));
+  return buffer;
+}
+
+Mesh uploadMeshData(const MeshData& data) {
+  Mesh mesh = {0};
+  mesh.vertexCount = data.getVertexCount();
+  mesh.triangleCount = data.getTriangleCount();
+  mesh.vertices = copyToRaylib(data.vertices);
+  mesh.texcoords = copyToRaylib(data.texcoords);
+  mesh.normals = copyToRaylib(data.normals);
+  mesh.colors = copyToRaylib(data.colors);
+  mesh.indices = copyToRaylib(data.indices);
+  UploadMesh(&mesh, false);
+  return mesh;
+}
+
+void MazeMesh::load(const MazeGeometry& geometry, const Texture2D& wall_texture,
+                    const Texture2D& floor_texture) {
+  if (loaded) unload();
+
+  floor_material = LoadMaterialDefault();
+  SetMaterialTexture(&floor_material, MATERIAL_MAP_DIFFUSE, floor_texture);
+  floor_material.maps[MATERIAL_MAP_DIFFUSE].color = LIGHTGRAY;
+
+  wall_material = LoadMaterialDefault();
+  SetMaterialTexture(&wall_material, MATERIAL_MAP_DIFFUSE, wall_texture);
+  wall_material.maps[MATERIAL_MAP_DIFFUSE].color = GRAY;
+
+  chunks.clear();
+  chunks.reserve(geometry.getChunks().size());
+  for (const MeshChunk& chunk : geometry.getChunks()) {
+    GpuChunk gpu_chunk = {};
+    gpu_chunk.has_floor = !chunk.floor.empty();
+    gpu_chunk.has_walls = !chunk.walls.empty();
+    if (gpu_chunk.has_floor) gpu_chunk.floor = uploadMeshData(chunk.floor);
+    if (gpu_chunk.has_walls) gpu_chunk.walls = uploadMeshData(chunk.walls);
+    chunks.push_back(gpu_chunk);
+  }
+
+  loaded = true;
+}
+
+void MazeMesh::drawChunk(int index, const Vector3& offset) const {
+  const GpuChunk& chunk = chunks[index];
+  const Matrix transform = MatrixTranslate(offset.x, offset.y, offset.z);
+  if (chunk.has_floor) DrawMesh(chunk.floor, floor_material, transform);
+  if (chunk.has_walls) DrawMesh(chunk.walls, wall_material, transform);
+}
+
+void MazeMesh::draw() const {
+  if (!loaded) return;
+
+  for (int i = 0; i < static_cast<int>(chunks.size()); ++i) {
+    drawChunk(i);
+  }
+}
+
+void MazeMesh::unload() {
+  if (!loaded) return;
+
+  for (const GpuChunk& chunk : chunks) {
+    if (chunk.has_floor) UnloadMesh(chunk.floor);
+    if (chunk.has_walls) UnloadMesh(chunk.walls);
+  }
+  chunks.clear();
+
+  // UnloadMaterial() would also unload the textures, which belong to the caller
+  MemFree(floor_material.maps);
+  MemFree(wall_material.maps);
+  loaded = false;
+}
@@ -0,0 +1,44 @@
+/*
+Maze Mesh - GPU-resident maze geometry
+
+Uploads the chunked meshes built by MazeGeometry once, and draws them with one draw call per
+texture and chunk.
+*/
+#pragma once
+
+#include <vector>
+
+#include "maze-geometry/maze-geometry.hpp"
+#include "raylib.h"
+
+// MazeMesh class owning the uploaded maze meshes
+class MazeMesh {
+  // Uploaded meshes of one chunk
+  struct GpuChunk {
+    Mesh floor;
+    Mesh walls;
+    bool has_floor;
+    bool has_walls;
+  };
+
+  std::vector<GpuChunk> chunks;  // uploaded chunks, same order as MazeGeometry::getChunks()
+  Material floor_material;       // floor texture and tint
+  Material wall_material;        // wall texture and tint
+  bool loaded = false;           // whether the meshes are on the GPU
+
+ public:
+  bool isLoaded() const { return loaded; }
+
+  // Upload the geometry; the textures stay owned by the caller
+  void load(const MazeGeometry& geometry, const Texture2D& wall_texture,
+            const Texture2D& floor_texture);
+  // Draw every chunk
+  void draw() const;
+  // Draw a single chunk, moved by an offset
+  void drawChunk(int index, const Vector3& offset = {0.0f, 0.0f, 0.0f}) const;
+  // Release the GPU meshes (must run before the window is closed)
+  void unload();
+};
+
+// Copy mesh data into a raylib mesh and upload it
+Mesh uploadMeshData(const MeshData& data);
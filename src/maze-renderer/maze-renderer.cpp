@@ -0,0 +1,172 @@
+#include "maze-renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "maze-geometry/ambient-occlusion.hpp"
+#include "rlgl.h"
+#include "utils/conversions.hpp"
+
+ViewParams getViewParams(const Camera& camera) {
+  return {helper::toVec3(camera.position),
+          helper::toVec3(camera.target),
+          helper::toVec3(camera.up),
+          camera.fovy,
+          static_cast<float>(GetScreenWidth()) / GetScreenHeight(),
+          static_cast<float>(RL_CULL_DISTANCE_NEAR),
+          static_cast<float>(RL_CULL_DISTANCE_FAR)};
+}
+
+MazeRenderer::MazeRenderer(const MazeGenerator& maze) : maze(maze) {}
+
+void MazeRenderer::draw() {
+  const MazeGrid& grid = maze.getGrid();
+  const GenerationState state = maze.getState();
+  const int screen_width = GetScreenWidth();
+  const int screen_height = GetScreenHeight();
+
+  BeginMode2D(view);
+  tiles.draw(maze, view, screen_width, screen_height, CELL_SIZE);
+
+  // cells in view, for the overlays
+  const Vector2 top_left = GetScreenToWorld2D({0.0f, 0.0f}, view);
+  const Vector2 bottom_right = GetScreenToWorld2D(
+      {static_cast<float>(screen_width), static_cast<float>(screen_height)}, view);
+  const int min_x = static_cast<int>(std::floor(top_left.x / CELL_SIZE));
+  const int min_y = static_cast<int>(std::floor(top_left.y / CELL_SIZE));
+  const int max_x = static_cast<int>(std::floor(bottom_right.x / CELL_SIZE));
+  const int max_y = static_cast<int>(std::floor(bottom_right.y / CELL_SIZE));
+  auto inView = [&](int cell) {
+    const int x = grid.cellX(cell);
+    const int y = grid.cellY(cell);
+    return x >= min_x && x <= max_x && y >= min_y && y <= max_y;
+  };
+
+  if (state == IN_PROGRESS) {
+    const int current = maze.getCurrentCell();
+    if (current != MazeGrid::NO_CELL) {
+      int x = grid.cellX(current) * CELL_SIZE;
+      int y = grid.cellY(current) * CELL_SIZE;
+      DrawRectangle(x, y, CELL_SIZE, CELL_SIZE, PURPLE);  // Highlight the current cell
+    }
+  } else if (state == COMPLETED) {
+    const std::vector<int>& path = maze.getPath();
+    for (int i = 0; i < maze.getRevealedPathNodes(); i++) {
+      if (!inView(path[i])) continue;
+      int x = grid.cellX(path[i]) * CELL_SIZE;
+      int y = grid.cellY(path[i]) * CELL_SIZE;
+      int t = 5;
+      DrawRectangle(x + t, y + t, CELL_SIZE - 2 * t, CELL_SIZE - 2 * t,
+                    GREEN);  // Highlight the path
+    }
+  }
+
+  if (state != NOT_STARTED) {
+    // start and end points
+    DrawRectangle(0, 0, CELL_SIZE, CELL_SIZE, MAGENTA);
+    DrawRectangle((grid.getCols() - 1) * CELL_SIZE, (grid.getRows() - 1) * CELL_SIZE, CELL_SIZE,
+                  CELL_SIZE, RED);
+  }
+  EndMode2D();
+}
+
+void MazeRenderer::resetView(int screen_width, int screen_height) {
+  const MazeGrid& grid = maze.getGrid();
+  const float fit_x = static_cast<float>(screen_width) / (grid.getCols() * CELL_SIZE);
+  const float fit_y = static_cast<float>(screen_height) / (grid.getRows() * CELL_SIZE);
+  min_zoom = std::min({1.0f, fit_x, fit_y});
+  view = {{0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f, min_zoom};
+}
+
+void MazeRenderer::pan(Vector2 screen_delta) {
+  view.target.x += screen_delta.x / view.zoom;
+  view.target.y += screen_delta.y / view.zoom;
+}
+
+void MazeRenderer::zoomAt(Vector2 screen_point, float factor) {
+  // anchor the view on the point so it stays under the same pixel
+  view.target = GetScreenToWorld2D(screen_point, view);
+  view.offset = screen_point;
+  view.zoom = std::clamp(view.zoom * factor, min_zoom, MAX_ZOOM);
+}
+
+void MazeRenderer::unload() {
+  mesh.unload();
+  tiles.unload();
+}
+
+void MazeRenderer::cullChunks(const Camera& camera) {
+  const ViewParams view = getViewParams(camera);
+  const MazeGrid& grid = maze.getGrid();
+  const int chunks_x = geometry.getChunksX();
+  const int chunks_z = geometry.getChunksZ();
+
+  // portals only hold while the eye is below the top of the walls
+  if (view.position.y < maze.getWallHeight()) {
+    chunk_visible.assign(geometry.getChunks().size(), 0);
+    portal_culler.compute(grid, maze.getFloorDimension(), view);
+
+    // walls on the right/bottom edge of a cell live in the next cell's chunk
+    const int chunk_size = MazeGeometry::CHUNK_SIZE;
+    for (const int cell : portal_culler.getVisibleCells()) {
+      const int x = grid.cellX(cell) / chunk_size;
+      const int z = grid.cellY(cell) / chunk_size;
+      const int next_x = std::min(grid.cellX(cell) + 1, grid.getCols() - 1) / chunk_size;
+      const int next_z = std::min(grid.cellY(cell) + 1, grid.getRows() - 1) / chunk_size;
+      chunk_visible[z * chunks_x + x] = 1;
+      chunk_visible[z * chunks_x + next_x] = 1;
+      chunk_visible[next_z * chunks_x + x] = 1;
+    }
+  } else {
+    chunk_visible.assign(geometry.getChunks().size(), 1);
+  }
+
+  const Frustum frustum(view);
+  for (int i = 0; i < chunks_x * chunks_z; ++i) {
+    if (chunk_visible[i] && !frustum.intersects(geometry.getChunks()[i].bounds)) {
+      chunk_visible[i] = 0;
+    }
+  }
+}
+
+void MazeRenderer::prepare3D(ThreadPool* pool) {
+  if (maze.getState() != COMPLETED || prepared) return;
+  geometry.build(maze);
+  bakeAmbientOcclusion(geometry, maze, pool);
+  prepared = true;
+}
+
+void MazeRenderer::draw3D(const bool& show_path, const Texture2D& wall_texture,
+                          const Texture2D& floor_texture, const Camera& camera) {
+  if (maze.getState() != COMPLETED || !prepared) return;
+
+  // only the upload needs the GL context, so it waits for the first draw
+  if (!mesh.isLoaded()) mesh.load(geometry, wall_texture, floor_texture);
+
+  // floor tiles and walls of the potentially visible chunks
+  cullChunks(camera);
+  drawn_chunks = 0;
+  for (int i = 0; i < static_cast<int>(chunk_visible.size()); ++i) {
+    if (!chunk_visible[i]) continue;
+    mesh.drawChunk(i);
+    drawn_chunks++;
+  }
+
+  // debugging
+  // for (const auto& wall_bbox : maze.getWallBBoxes()) {
+  //   DrawBoundingBox(helper::toBoundingBox(wall_bbox), RED);
+  // }
+
+  // draw the path
+  if (show_path) {
+    const MazeGrid& grid = maze.getGrid();
+    const BoxSize3D& floor_dimension = maze.getFloorDimension();
+    for (const int cell : maze.getPath()) {
+      const BoxSize3D path_tile_dimension = {0.5f, 0.2f, 0.5f};
+      const Vector3 path_cell_pos = {grid.cellX(cell) * floor_dimension.width, 0.1f,
+                                     grid.cellY(cell) * floor_dimension.depth};
+      DrawCube(path_cell_pos, path_tile_dimension.width, path_tile_dimension.height,
+               path_tile_dimension.depth, GREEN);
+    }
+  }
+}
@@ -0,0 +1,67 @@
+/*
+Maze Renderer
+
+Draws the state of a MazeGenerator with raylib: the 2D generation view and the 3D maze.
+*/
+#pragma once
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/maze-generator.hpp"
+#include "maze-geometry/maze-geometry.hpp"
+#include "maze-mesh.hpp"
+#include "maze-tiles.hpp"
+#include "raylib.h"
+#include "visibility/visibility.hpp"
+
+// Get the view parameters of a raylib camera drawing to the current screen
+ViewParams getViewParams(const Camera& camera);
+
+// MazeRenderer class to draw a maze
+class MazeRenderer {
+ public:
+  static constexpr int CELL_SIZE = 20;     // size of each cell in the 2D view, in world units
+  static constexpr float MAX_ZOOM = 4.0f;  // screen pixels per 2D world unit, zoomed in
+
+ private:
+  const MazeGenerator& maze;           // maze to draw
+  MazeGeometry geometry;               // static maze meshes, built once the maze is completed
+  bool prepared = false;               // geometry built and its occlusion baked
+  MazeMesh mesh;                       // the same meshes uploaded to the GPU
+  PortalCuller portal_culler;          // cells visible from the camera through open walls
+  std::vector<uint8_t> chunk_visible;  // chunks to draw this frame
+  int drawn_chunks = 0;                // number of chunks drawn last frame
+  MazeTiles tiles;                     // cached textures of the 2D view
+  float min_zoom = 1.0f;               // zoom showing the whole maze, or 1 for small mazes
+  Camera2D view = {{0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f, 1.0f};  // 2D view, CELL_SIZE units per cell
+
+  // Mark the chunks holding potentially visible geometry for this frame
+  void cullChunks(const Camera& camera);
+
+ public:
+  MazeRenderer(const MazeGenerator& maze);
+
+  // Draw the 2D view: walls and visited cells from the tile cache, then the current cell, the
+  // revealed path and the start/end markers, all culled to the part of the maze in view.
+  // Mazes tracking their changes (MazeGenerator::setChangeTracking) only redraw changed tiles.
+  void draw();
+  // Fit the 2D view to a screen: the whole maze if it is larger, else at its natural size
+  void resetView(int screen_width, int screen_height);
+  // Move the 2D view by a distance in screen pixels
+  void pan(Vector2 screen_delta);
+  // Scale the 2D zoom by a factor, keeping the maze point under a screen point in place
+  void zoomAt(Vector2 screen_point, float factor);
+  const Camera2D& getView() const { return view; }
+  const MazeTiles& getTiles() const { return tiles; }
+  // Build the static meshes of the completed maze and bake their occlusion, spread over the pool
+  // (nullptr: on the calling thread); call once when the generation completes
+  void prepare3D(ThreadPool* pool);
+  bool isPrepared() const { return prepared; }
+  // Draw the completed maze as seen from the camera once prepare3D() ran; the meshes are
+  // uploaded on the first call, then only the chunks that pass frustum and portal culling are
+  // drawn
+  void draw3D(const bool& show_path, const Texture2D& wall_texture, const Texture2D& floor_texture,
+              const Camera& camera);
+  int getDrawnChunks() const { return drawn_chunks; }
+  // Release the GPU meshes and tiles (must run before the window is closed)
+  void unload();
+};
@@ -0,0 +1,145 @@
+#include "maze-tiles.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static_assert(MazeGenerator::REGION_SIZE == MazeRasterizer::BASE_TILE_CELLS,
+              "a level 0 tile must cover exactly one change-tracking region");
+
+uint64_t MazeTiles::tileKey(int level, int tile_x, int tile_y) {
+  return (static_cast<uint64_t>(level) << 56) | (static_cast<uint64_t>(tile_y) << 28) |
+         static_cast<uint64_t>(tile_x);
+}
+
+int MazeTiles::chooseLevel(const MazeGrid& grid, float cell_pixels) {
+  // the coarsest level covers the whole maze with a single tile
+  const int extent = std::max(grid.getCols(), grid.getRows());
+  int max_level = 0;
+  while (MazeRasterizer::getTileCells(max_level) < extent) max_level++;
+
+  // texels per cell halve with every level
+  const float base_texels = static_cast<float>(MazeRasterizer::TILE_TEXELS) /
+                            MazeRasterizer::BASE_TILE_CELLS;
+  int level = 0;
+  while (level < max_level && base_texels / (1 << level) > 2.0f * cell_pixels) level++;
+  return level;
+}
+
+uint32_t MazeTiles::getTileRevision(const MazeGenerator& maze, int level, int tile_x,
+                                    int tile_y) {
+  const MazeGrid& grid = maze.getGrid();
+  const int regions = 1 << level;  // regions per side of the tile
+  const int regions_x = (grid.getCols() + MazeGenerator::REGION_SIZE - 1) /
+                        MazeGenerator::REGION_SIZE;
+  const int regions_y = (grid.getRows() + MazeGenerator::REGION_SIZE - 1) /
+                        MazeGenerator::REGION_SIZE;
+  const int rx1 = std::min((tile_x + 1) * regions, regions_x);
+  const int ry1 = std::min((tile_y + 1) * regions, regions_y);
+
+  uint32_t newest = 0;
+  for (int ry = tile_y * regions; ry < ry1; ++ry) {
+    for (int rx = tile_x * regions; rx < rx1; ++rx) {
+      newest = std::max(newest, maze.getRegionRevision(rx, ry));
+    }
+  }
+  return newest;
+}
+
+void MazeTiles::redraw(const MazeGenerator& maze, int level, int tile_x, int tile_y, Tile& tile) {
+  tile.revision = getTileRevision(maze, level, tile_x, tile_y);
+  tile.extent = rasterizer.rasterize(maze.getGrid(), level, tile_x, tile_y,
+                                     maze.getState() == IN_PROGRESS, pixels);
+
+  if (tile.texture.id == 0) {
+    if (!free_textures.empty()) {
+      tile.texture = free_textures.back();
+      free_textures.pop_back();
+    } else {
+      const Image image = {pixels.data(), MazeRasterizer::TILE_TEXELS,
+                           MazeRasterizer::TILE_TEXELS, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+      tile.texture = LoadTextureFromImage(image);
+    }
+    // magnified tiles keep their lines sharp; minified ones blend neighbouring texels
+    SetTextureFilter(tile.texture, level == 0 ? TEXTURE_FILTER_POINT : TEXTURE_FILTER_BILINEAR);
+  }
+  UpdateTexture(tile.texture, pixels.data());
+  redrawn_tiles++;
+}
+
+void MazeTiles::evict() {
+  if (static_cast<int>(tiles.size()) <= MAX_RESIDENT_TILES) return;
+
+  // tiles drawn this frame are never evicted
+  std::vector<std::pair<uint64_t, uint64_t>> candidates;  // (last use, key)
+  for (const auto& [key, tile] : tiles) {
+    if (tile.last_used != frame) candidates.emplace_back(tile.last_used, key);
+  }
+  const std::size_t excess = std::min(tiles.size() - MAX_RESIDENT_TILES, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + excess, candidates.end());
+  for (std::size_t i = 0; i < excess; ++i) {
+    auto it = tiles.find(candidates[i].second);
+    if (static_cast<int>(free_textures.size()) < MAX_REDRAWS_PER_FRAME) {
+      free_textures.push_back(it->second.texture);
+    } else {
+      UnloadTexture(it->second.texture);
+    }
+    tiles.erase(it);
+  }
+}
+
+void MazeTiles::draw(const MazeGenerator& maze, const Camera2D& camera, int screen_width,
+                     int screen_height, float cell_size) {
+  const MazeGrid& grid = maze.getGrid();
+  frame++;
+  drawn_tiles = 0;
+  redrawn_tiles = 0;
+
+  const int level = chooseLevel(grid, camera.zoom * cell_size);
+  const int tile_cells = MazeRasterizer::getTileCells(level);
+  const float tile_size = tile_cells * cell_size;  // world units per side of a tile
+  const int tiles_x = (grid.getCols() + tile_cells - 1) / tile_cells;
+  const int tiles_y = (grid.getRows() + tile_cells - 1) / tile_cells;
+
+  // tiles overlapping the view
+  const Vector2 top_left = GetScreenToWorld2D({0.0f, 0.0f}, camera);
+  const Vector2 bottom_right = GetScreenToWorld2D(
+      {static_cast<float>(screen_width), static_cast<float>(screen_height)}, camera);
+  const int tx0 = std::max(0, static_cast<int>(std::floor(top_left.x / tile_size)));
+  const int ty0 = std::max(0, static_cast<int>(std::floor(top_left.y / tile_size)));
+  const int tx1 = std::min(tiles_x, static_cast<int>(std::floor(bottom_right.x / tile_size)) + 1);
+  const int ty1 = std::min(tiles_y, static_cast<int>(std::floor(bottom_right.y / tile_size)) + 1);
+
+  const float texel_size = tile_size / MazeRasterizer::TILE_TEXELS;
+  for (int ty = ty0; ty < ty1; ++ty) {
+    for (int tx = tx0; tx < tx1; ++tx) {
+      auto it = tiles.find(tileKey(level, tx, ty));
+      if (it == tiles.end()) {
+        // not drawn before: wait for a later frame once the redraw budget is spent
+        if (redrawn_tiles >= MAX_REDRAWS_PER_FRAME) continue;
+        it = tiles.emplace(tileKey(level, tx, ty), Tile{}).first;
+        redraw(maze, level, tx, ty, it->second);
+      } else if (redrawn_tiles < MAX_REDRAWS_PER_FRAME &&
+                 getTileRevision(maze, level, tx, ty) > it->second.revision) {
+        redraw(maze, level, tx, ty, it->second);  // stale tiles keep their old pixels meanwhile
+      }
+
+      Tile& tile = it->second;
+      tile.last_used = frame;
+      const Rectangle source = {0.0f, 0.0f, static_cast<float>(tile.extent.width),
+                                static_cast<float>(tile.extent.height)};
+      const Rectangle dest = {tx * tile_size, ty * tile_size, tile.extent.width * texel_size,
+                              tile.extent.height * texel_size};
+      DrawTexturePro(tile.texture, source, dest, {0.0f, 0.0f}, 0.0f, WHITE);
+      drawn_tiles++;
+    }
+  }
+
+  evict();
+}
+
+void MazeTiles::unload() {
+  for (const auto& [key, tile] : tiles) UnloadTexture(tile.texture);
+  for (const Texture2D& texture : free_textures) UnloadTexture(texture);
+  tiles.clear();
+  free_textures.clear();
+}
@@ -0,0 +1,63 @@
+/*
+Maze Tiles - Cached, viewport-culled 2D maze view
+
+Keeps square tiles of the 2D maze as textures and draws only the tiles inside the view. Tiles are
+rasterized on the CPU by MazeRasterizer and redrawn only when a region they cover changed, a few
+per frame. The tile level follows the zoom, so a 1000x1000 maze zoomed out is drawn from a
+handful of coarse tiles instead of millions of lines.
+*/
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "maze-generator/maze-generator.hpp"
+#include "maze-geometry/maze-raster.hpp"
+#include "raylib.h"
+
+// MazeTiles class to draw the 2D maze from cached textures
+class MazeTiles {
+ public:
+  static constexpr int MAX_RESIDENT_TILES = 128;  // tiles kept as textures (256 KiB each)
+  static constexpr int MAX_REDRAWS_PER_FRAME = 8;  // tiles rasterized per frame, to avoid hitches
+
+ private:
+  // Texture of one tile and the maze revision it was drawn from
+  struct Tile {
+    Texture2D texture;    // tile pixels on the GPU
+    RasterExtent extent;  // texels holding cells
+    uint32_t revision;    // newest region revision the texture shows
+    uint64_t last_used;   // frame the tile was last drawn
+  };
+
+  MazeRasterizer rasterizer;                 // draws tiles into pixels
+  std::vector<uint32_t> pixels;              // pixels of the tile being rasterized
+  std::unordered_map<uint64_t, Tile> tiles;  // resident tiles by level and position
+  std::vector<Texture2D> free_textures;      // textures of evicted tiles, reused for new ones
+  uint64_t frame = 0;                        // frames drawn so far
+  int drawn_tiles = 0;                       // number of tiles drawn last frame
+  int redrawn_tiles = 0;                     // number of tiles rasterized last frame
+
+  static uint64_t tileKey(int level, int tile_x, int tile_y);
+  // Newest revision of the change-tracking regions a tile covers
+  static uint32_t getTileRevision(const MazeGenerator& maze, int level, int tile_x, int tile_y);
+  // Rasterize a tile into its texture, creating the texture if needed
+  void redraw(const MazeGenerator& maze, int level, int tile_x, int tile_y, Tile& tile);
+  // Release the least recently drawn tiles beyond MAX_RESIDENT_TILES
+  void evict();
+
+ public:
+  // Level whose texels are at most twice as fine as the screen pixels, for cells of
+  // cell_pixels pixels on screen
+  static int chooseLevel(const MazeGrid& grid, float cell_pixels);
+
+  // Draw the tiles seen by camera on a screen of screen_width x screen_height pixels, with cells
+  // of cell_size world units; must run inside BeginMode2D(camera)
+  void draw(const MazeGenerator& maze, const Camera2D& camera, int screen_width,
+            int screen_height, float cell_size);
+  int getDrawnTiles() const { return drawn_tiles; }
+  int getRedrawnTiles() const { return redrawn_tiles; }
+  // Release the textures (must run before the window is closed)
+  void unload();
+};
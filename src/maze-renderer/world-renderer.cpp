@@ -0,0 +1,43 @@
+#include "world-renderer.hpp"
+
+#include "maze-renderer.hpp"
+#include "utils/conversions.hpp"
+#include "visibility/visibility.hpp"
+
+void WorldRenderer::draw3D(const MazeWorld& world, const Texture2D& wall_texture,
+                           const Texture2D& floor_texture, const Camera& camera) {
+  // release the meshes of chunks the world evicted (or regenerated)
+  for (auto it = uploaded.begin(); it != uploaded.end();) {
+    const WorldChunk* chunk = world.findChunk(it->second.coord);
+    if (chunk && chunk->serial == it->second.serial) {
+      ++it;
+      continue;
+    }
+    it->second.mesh.unload();
+    it = uploaded.erase(it);
+  }
+
+  const Frustum frustum(getViewParams(camera));
+  int uploads = 0;
+  drawn_chunks = 0;
+  world.forEachChunk([&](const WorldChunk& chunk) {
+    if (!frustum.intersects(chunk.bounds)) return;
+
+    const uint64_t key = chunkKey(chunk.coord);
+    auto it = uploaded.find(key);
+    if (it == uploaded.end()) {
+      if (uploads == MAX_UPLOADS_PER_FRAME) return;
+      it = uploaded.emplace(key, UploadedChunk{chunk.coord, chunk.serial, MazeMesh()}).first;
+      it->second.mesh.load(chunk.geometry, wall_texture, floor_texture);
+      uploads++;
+    }
+
+    it->second.mesh.drawChunk(0, helper::toVector3(chunk.offset));
+    drawn_chunks++;
+  });
+}
+
+void WorldRenderer::unload() {
+  for (auto& entry : uploaded) entry.second.mesh.unload();
+  uploaded.clear();
+}
@@ -0,0 +1,40 @@
+/*
+World Renderer
+
+Draws the resident chunks of a MazeWorld with raylib. Chunk meshes are uploaded a few per frame as
+the workers finish them, and released once the world evicts their chunk.
+*/
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "maze-mesh.hpp"
+#include "maze-world/maze-world.hpp"
+#include "raylib.h"
+
+// WorldRenderer class to draw an endless maze world
+class WorldRenderer {
+ public:
+  static constexpr int MAX_UPLOADS_PER_FRAME = 2;  // chunk uploads per frame, to avoid hitches
+
+ private:
+  // Meshes of one chunk on the GPU
+  struct UploadedChunk {
+    ChunkCoord coord;  // chunk the meshes belong to
+    uint64_t serial;   // generated instance the meshes were built from
+    MazeMesh mesh;     // uploaded meshes
+  };
+
+  std::unordered_map<uint64_t, UploadedChunk> uploaded;  // uploaded chunks by chunk key
+  int drawn_chunks = 0;                                  // number of chunks drawn last frame
+
+ public:
+  // Draw the resident chunks inside the camera frustum, uploading new chunks and releasing the
+  // meshes of evicted ones
+  void draw3D(const MazeWorld& world, const Texture2D& wall_texture, const Texture2D& floor_texture,
+              const Camera& camera);
+  int getDrawnChunks() const { return drawn_chunks; }
+  // Release the GPU meshes (must run before the window is closed)
+  void unload();
+};
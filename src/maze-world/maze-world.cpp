@@ -0,0 +1,129 @@
+#include "maze-world.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "maze-geometry/ambient-occlusion.hpp"
+
+// Mix a seed with chunk coordinates and a salt into a well-distributed 64-bit value
+static uint64_t hashChunk(uint32_t seed, int x, int z, uint32_t salt) {
+  uint64_t h = (static_cast<uint64_t>(seed) << 32) ^ salt;
+  h ^= static_cast<uint64_t>(static_cast<uint32_t>(x)) * 0x9E3779B97F4A7C15ull;
+  h ^= static_cast<uint64_t>(static_cast<uint32_t>(z)) * 0xC2B2AE3D27D4EB4Full;
+  // splitmix64 finalizer
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return h ^ (h >> 31);
+}
+
+// Salts of the values hashed per chunk
+enum ChunkHash : uint32_t {
+  HASH_EAST_OPENING = 1,   // row of the passage through the chunk's east border
+  HASH_SOUTH_OPENING = 2,  // column of the passage through the chunk's south border
+  HASH_MAZE_SEED = 3       // seed of the chunk's maze
+};
+
+WorldChunk::WorldChunk(const ChunkCoord& coord, uint64_t serial, int cells)
+    : coord(coord), serial(serial), offset{0.0f, 0.0f, 0.0f}, bounds{}, maze(cells, cells) {}
+
+MazeWorld::MazeWorld(uint32_t seed, int load_radius, std::size_t cache_capacity,
+                     int worker_threads)
+    : seed(seed),
+      load_radius(load_radius),
+      cache_capacity(std::max(cache_capacity,
+                              static_cast<std::size_t>((2 * load_radius + 1) *
+                                                       (2 * load_radius + 1)))),
+      cell_size(MazeGenerator(1, 1).getFloorDimension()),
+      pool(worker_threads) {}
+
+ChunkCoord MazeWorld::chunkAt(const Vec3& position) const {
+  // cell (0, 0) is centered on the origin, so chunk (0, 0) starts half a cell before it
+  return {static_cast<int>(std::floor((position.x + cell_size.width / 2) / chunkWidth())),
+          static_cast<int>(std::floor((position.z + cell_size.depth / 2) / chunkDepth()))};
+}
+
+const WorldChunk* MazeWorld::findChunk(const ChunkCoord& coord) const {
+  const auto it = chunks.find(chunkKey(coord));
+  return it != chunks.end() ? it->second.chunk.get() : nullptr;
+}
+
+std::unique_ptr<WorldChunk> MazeWorld::generateChunk(const ChunkCoord& coord,
+                                                     uint64_t serial) const {
+  auto chunk = std::make_unique<WorldChunk>(coord, serial, CHUNK_CELLS);
+  MazeGenerator& maze = chunk->maze;
+  const MazeGrid& grid = maze.getGrid();
+  const int last = CHUNK_CELLS - 1;
+
+  // one passage per border; a border's position is hashed from the chunk west/north of it, so
+  // both chunks sharing the border agree on it
+  const int east = hashChunk(seed, coord.x, coord.z, HASH_EAST_OPENING) % CHUNK_CELLS;
+  const int west = hashChunk(seed, coord.x - 1, coord.z, HASH_EAST_OPENING) % CHUNK_CELLS;
+  const int south = hashChunk(seed, coord.x, coord.z, HASH_SOUTH_OPENING) % CHUNK_CELLS;
+  const int north = hashChunk(seed, coord.x, coord.z - 1, HASH_SOUTH_OPENING) % CHUNK_CELLS;
+  maze.addBorderOpening(grid.cellId(last, east), RIGHT);
+  maze.addBorderOpening(grid.cellId(0, west), LEFT);
+  maze.addBorderOpening(grid.cellId(south, last), BOTTOM);
+  maze.addBorderOpening(grid.cellId(north, 0), TOP);
+
+  // the east and south walls are emitted by the neighbours as their west and north walls
+  maze.setSharedBorders(true);
+  maze.setSeed(static_cast<uint32_t>(hashChunk(seed, coord.x, coord.z, HASH_MAZE_SEED)));
+  maze.finish_generation();
+  chunk->geometry.build(maze);
+  bakeAmbientOcclusion(chunk->geometry, maze);  // already on a worker
+
+  chunk->offset = {coord.x * chunkWidth(), 0.0f, coord.z * chunkDepth()};
+  const Vec3& o = chunk->offset;
+  const AABB& local = chunk->geometry.getChunks().front().bounds;
+  chunk->bounds = {{local.min.x + o.x, local.min.y + o.y, local.min.z + o.z},
+                   {local.max.x + o.x, local.max.y + o.y, local.max.z + o.z}};
+  return chunk;
+}
+
+void MazeWorld::update(const Vec3& position) {
+  // collect the chunks finished since the last update
+  std::vector<std::unique_ptr<WorldChunk>> finished;
+  {
+    std::lock_guard<std::mutex> lock(ready_mutex);
+    finished.swap(ready);
+  }
+  for (std::unique_ptr<WorldChunk>& chunk : finished) {
+    const uint64_t key = chunkKey(chunk->coord);
+    pending.erase(key);
+    lru.push_front(key);
+    chunks[key] = {std::move(chunk), lru.begin()};
+  }
+
+  // touch the chunks around the position, nearest first, and request the missing ones
+  const ChunkCoord center = chunkAt(position);
+  for (int ring = 0; ring <= load_radius; ++ring) {
+    for (int z = center.z - ring; z <= center.z + ring; ++z) {
+      for (int x = center.x - ring; x <= center.x + ring; ++x) {
+        if (std::max(std::abs(x - center.x), std::abs(z - center.z)) != ring) continue;
+
+        const ChunkCoord coord = {x, z};
+        const uint64_t key = chunkKey(coord);
+        const auto it = chunks.find(key);
+        if (it != chunks.end()) {
+          lru.splice(lru.begin(), lru, it->second.lru_position);
+          continue;
+        }
+        if (!pending.insert(key).second) continue;
+
+        const uint64_t serial = next_serial++;
+        pool.submit([this, coord, serial] {
+          std::unique_ptr<WorldChunk> chunk = generateChunk(coord, serial);
+          std::lock_guard<std::mutex> lock(ready_mutex);
+          ready.push_back(std::move(chunk));
+        });
+      }
+    }
+  }
+
+  // the chunks around the position were just touched, so eviction never reaches them
+  while (chunks.size() > cache_capacity) {
+    chunks.erase(lru.back());
+    lru.pop_back();
+  }
+}
@@ -0,0 +1,143 @@
+/*
+Maze World - Endless chunked maze
+
+The world is an unbounded grid of square maze chunks. Every chunk is a perfect maze generated
+from the world seed and its coordinates, and opens one passage on each of its four borders at a
+position hashed from the shared edge, so neighbouring chunks always line up however they were
+generated. Chunks around the player are generated, indexed and meshed on worker threads; the
+least recently used chunks are dropped once the cache is full.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/maze-generator.hpp"
+#include "maze-geometry/maze-geometry.hpp"
+#include "utils/types.hpp"
+
+// Coordinates of a chunk in the world
+struct ChunkCoord {
+  int x;
+  int z;
+};
+
+// Pack chunk coordinates into a single map key
+inline uint64_t chunkKey(const ChunkCoord& coord) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) |
+         static_cast<uint32_t>(coord.z);
+}
+
+// Generated chunk of the world; maze and geometry are in chunk-local space
+struct WorldChunk {
+  ChunkCoord coord;       // position of the chunk in the world
+  uint64_t serial;        // unique id of this generated instance
+  Vec3 offset;            // world position of the chunk's cell (0, 0)
+  AABB bounds;            // world bounds of the chunk geometry
+  MazeGenerator maze;     // carved maze with its collision indices
+  MazeGeometry geometry;  // static meshes of the maze
+
+  WorldChunk(const ChunkCoord& coord, uint64_t serial, int cells);
+};
+
+// MazeWorld class streaming the chunks around the player
+class MazeWorld {
+ public:
+  static constexpr int CHUNK_CELLS = MazeGeometry::CHUNK_SIZE;  // cells per chunk side
+
+ private:
+  // Resident chunk and its place in the LRU list
+  struct CacheEntry {
+    std::unique_ptr<WorldChunk> chunk;
+    std::list<uint64_t>::iterator lru_position;
+  };
+
+  uint32_t seed;                // seed of the whole world
+  int load_radius;              // chunks kept generated around the player, in each direction
+  std::size_t cache_capacity;   // resident chunks kept at most
+  BoxSize3D cell_size;          // world size of one cell
+  uint64_t next_serial = 0;     // serial of the next requested chunk
+  std::unordered_map<uint64_t, CacheEntry> chunks;  // resident chunks
+  std::list<uint64_t> lru;                          // resident chunk keys, most recent first
+  std::unordered_set<uint64_t> pending;             // chunks queued or being generated
+  std::mutex ready_mutex;                           // guards ready
+  std::vector<std::unique_ptr<WorldChunk>> ready;   // generated chunks not collected yet
+  ThreadPool pool;  // chunk generation workers (last, so it stops before the rest is destroyed)
+
+  // Generate a chunk (runs on a worker thread)
+  std::unique_ptr<WorldChunk> generateChunk(const ChunkCoord& coord, uint64_t serial) const;
+  // World size of a chunk along x and z
+  float chunkWidth() const { return CHUNK_CELLS * cell_size.width; }
+  float chunkDepth() const { return CHUNK_CELLS * cell_size.depth; }
+
+ public:
+  // cache_capacity is raised to hold at least the chunks within load_radius
+  MazeWorld(uint32_t seed, int load_radius = 2, std::size_t cache_capacity = 64,
+            int worker_threads = 0);
+
+  // Collect the chunks finished by the workers, request the missing ones around the position
+  // and evict the least recently used chunks beyond the cache capacity
+  void update(const Vec3& position);
+
+  // Get the chunk containing a world position
+  ChunkCoord chunkAt(const Vec3& position) const;
+  // Get a resident chunk, nullptr if it is not generated yet
+  const WorldChunk* findChunk(const ChunkCoord& coord) const;
+  std::size_t getResidentChunks() const { return chunks.size(); }
+  std::size_t getPendingChunks() const { return pending.size(); }
+  const BoxSize3D& getCellSize() const { return cell_size; }
+
+  // Call fn for every resident chunk
+  template <typename Fn>
+  void forEachChunk(Fn&& fn) const {
+    for (const auto& entry : chunks) fn(*entry.second.chunk);
+  }
+
+  // Call fn(box) for the floor boxes near a world-space query box, in world space; stops as
+  // soon as fn returns true
+  template <typename Fn>
+  void forEachFloorNear(const AABB& query, Fn&& fn) const {
+    forEachNear(query, fn, [](const MazeGenerator& maze) -> const CollisionGrid& {
+      return maze.getFloorIndex();
+    });
+  }
+  // Same for the wall boxes
+  template <typename Fn>
+  void forEachWallNear(const AABB& query, Fn&& fn) const {
+    forEachNear(query, fn, [](const MazeGenerator& maze) -> const CollisionGrid& {
+      return maze.getWallIndex();
+    });
+  }
+
+ private:
+  template <typename Fn, typename Index>
+  void forEachNear(const AABB& query, Fn& fn, Index index) const {
+    // chunk (0, 0) starts half a cell before the origin, like the cells of a single maze
+    const ChunkCoord first = chunkAt(query.min);
+    const ChunkCoord last = chunkAt(query.max);
+    for (int z = first.z; z <= last.z; ++z) {
+      for (int x = first.x; x <= last.x; ++x) {
+        const WorldChunk* chunk = findChunk({x, z});
+        if (!chunk) continue;
+
+        const Vec3& o = chunk->offset;
+        const AABB local = {{query.min.x - o.x, query.min.y - o.y, query.min.z - o.z},
+                            {query.max.x - o.x, query.max.y - o.y, query.max.z - o.z}};
+        bool stopped = false;
+        index(chunk->maze).forEachNear(local, [&](const AABB& box) {
+          stopped = fn(AABB{{box.min.x + o.x, box.min.y + o.y, box.min.z + o.z},
+                            {box.max.x + o.x, box.max.y + o.y, box.max.z + o.z}});
+          return stopped;
+        });
+        if (stopped) return;
+      }
+    }
+  }
+};
@@ -0,0 +1,259 @@
+/*
+NeuroPath maze pack tool
+
+Generates reproducible mazes from explicit seeds on all cores into a pack file, prints the index
+and stats of a pack, or regenerates every maze of a pack and checks that it matches.
+
+With --target, only mazes whose difficulty metrics fall in every given range are kept: the
+seeds are searched upwards from --seed by parallel rejection sampling. Metrics are
+solution_length, turns, dead_ends, junctions, branching_factor, detour_ratio and max_deviation.
+
+Usage: neuropath_pack generate OUT [--count N] [--size WxH] [--algorithm NAME] [--seed N]
+                                   [--seeds FILE] [--target METRIC=MIN:MAX]... [--threads N]
+       neuropath_pack info PACK [--list]
+       neuropath_pack verify PACK [--threads N]
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-pack/maze-pack-writer.hpp"
+#include "maze-pack/maze-pack.hpp"
+#include "solver/maze-difficulty.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void printUsage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s generate OUT [--count N] [--size WxH] [--algorithm NAME] [--seed N]\n"
+               "                       [--seeds FILE] [--target METRIC=MIN:MAX]... [--threads N]\n"
+               "       %s info PACK [--list]\n"
+               "       %s verify PACK [--threads N]\n",
+               program, program, program);
+}
+
+// Read one decimal seed per line
+bool readSeeds(const char* file_name, std::vector<uint32_t>& seeds) {
+  FILE* file = std::fopen(file_name, "r");
+  if (!file) return false;
+  unsigned long seed = 0;
+  while (std::fscanf(file, "%lu", &seed) == 1) seeds.push_back(static_cast<uint32_t>(seed));
+  std::fclose(file);
+  return !seeds.empty();
+}
+
+// Parse METRIC=MIN:MAX into the range of that metric
+bool parseTarget(const char* text, DifficultyTarget& target) {
+  const std::pair<const char*, MetricRange*> metrics[] = {
+      {"solution_length", &target.solution_length},
+      {"turns", &target.turns},
+      {"dead_ends", &target.dead_ends},
+      {"junctions", &target.junctions},
+      {"branching_factor", &target.branching_factor},
+      {"detour_ratio", &target.detour_ratio},
+      {"max_deviation", &target.max_deviation}};
+  const char* equals = std::strchr(text, '=');
+  if (!equals) return false;
+  for (const auto& [name, range] : metrics) {
+    if (std::strncmp(text, name, equals - text) != 0 || name[equals - text] != '\0') continue;
+    return std::sscanf(equals + 1, "%f:%f", &range->min, &range->max) == 2 &&
+           range->min <= range->max;
+  }
+  return false;
+}
+
+// Scan the seeds upwards from first_seed for the first `count` mazes that match the target
+bool findSeeds(int count, int cols, int rows, GenerationAlgorithm algorithm,
+               const DifficultyTarget& target, uint32_t first_seed, ThreadPool* pool,
+               std::vector<uint32_t>& seeds) {
+  const int MAX_MISSES = 100000;  // seeds in a row without a match before giving up on the target
+  const Clock::time_point start = Clock::now();
+  const TargetedSeeds found =
+      findTargetSeeds(cols, rows, algorithm, target, first_seed, count, MAX_MISSES, pool);
+  if (static_cast<int>(found.seeds.size()) < count) {
+    std::fprintf(stderr, "No maze in %d candidates from seed %u matches the target\n", MAX_MISSES,
+                 found.seeds.empty() ? first_seed : found.seeds.back() + 1);
+    return false;
+  }
+  seeds.insert(seeds.end(), found.seeds.begin(), found.seeds.end());
+  const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  std::printf("Found %d matching seeds in %lld candidates (%.1f%% accepted, %.2f ms per maze)\n",
+              count, found.candidates, 100.0 * count / found.candidates, ms / count);
+  return true;
+}
+
+int generate(int argc, char** argv) {
+  const char* out_name = argv[2];
+  int count = 1000;
+  int cols = 40;
+  int rows = 20;
+  GenerationAlgorithm algorithm = GenerationAlgorithm::DFS;
+  uint32_t first_seed = 1;
+  std::vector<uint32_t> seeds;
+  DifficultyTarget target;
+  bool targeted = false;
+  int threads = 0;
+
+  for (int i = 3; i < argc; ++i) {
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--count") == 0 && has_value) {
+      count = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--size") == 0 && has_value &&
+               std::sscanf(argv[i + 1], "%dx%d", &cols, &rows) == 2 && cols > 0 && rows > 0 &&
+               cols <= UINT16_MAX && rows <= UINT16_MAX && (cols > 1 || rows > 1)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--algorithm") == 0 && has_value &&
+               parseAlgorithmName(argv[i + 1], algorithm)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+      first_seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--seeds") == 0 && has_value) {
+      if (!readSeeds(argv[++i], seeds)) {
+        std::fprintf(stderr, "No seeds in %s\n", argv[i]);
+        return 1;
+      }
+    } else if (std::strcmp(argv[i], "--target") == 0 && has_value &&
+               parseTarget(argv[i + 1], target)) {
+      targeted = true;
+      ++i;
+    } else if (std::strcmp(argv[i], "--threads") == 0 && has_value) {
+      threads = std::atoi(argv[++i]);
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  // the calling thread runs a share of the work too
+  const std::unique_ptr<ThreadPool> pool = createThreadPool(threads);
+
+  // a seed file gives one maze per seed; otherwise the seeds count up from --seed, skipping
+  // the mazes that miss the target
+  if (targeted && seeds.empty()) {
+    if (!findSeeds(count, cols, rows, algorithm, target, first_seed, pool.get(), seeds)) return 1;
+  } else if (seeds.empty()) {
+    for (int i = 0; i < count; ++i) seeds.push_back(first_seed + static_cast<uint32_t>(i));
+  }
+  std::vector<MazePackRequest> requests;
+  requests.reserve(seeds.size());
+  for (const uint32_t seed : seeds) requests.push_back({seed, algorithm, cols, rows});
+
+  const int thread_count = pool ? pool->getThreadCount() + 1 : 1;
+  std::printf("Generating %zu %dx%d %s mazes on %d thread%s\n", requests.size(), cols, rows,
+              getAlgorithmName(algorithm), thread_count, thread_count > 1 ? "s" : "");
+  const Clock::time_point start = Clock::now();
+  if (!writeMazePack(out_name, requests, pool.get())) {
+    std::fprintf(stderr, "Failed to write %s\n", out_name);
+    return 1;
+  }
+  const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  std::printf("%zu mazes written to %s in %.2f s (%.0f mazes/s)\n", requests.size(), out_name,
+              seconds, requests.size() / seconds);
+  return 0;
+}
+
+int info(const MazePack& pack, bool list) {
+  if (list) {
+    std::printf("index,seed,algorithm,cols,rows,solution_length,solution_turns,dead_ends,"
+                "junctions\n");
+    for (int i = 0; i < pack.getMazeCount(); ++i) {
+      const MazePackEntry& e = pack.getEntry(i);
+      std::printf("%d,%u,%s,%u,%u,%u,%u,%u,%u\n", i, e.seed,
+                  getAlgorithmName(static_cast<GenerationAlgorithm>(e.algorithm)), e.cols, e.rows,
+                  e.solution_length, e.solution_turns, e.dead_ends, e.junctions);
+    }
+    return 0;
+  }
+
+  uint32_t min_length = UINT32_MAX;
+  uint32_t max_length = 0;
+  double total_length = 0.0;
+  double total_dead_ends = 0.0;
+  for (int i = 0; i < pack.getMazeCount(); ++i) {
+    const MazePackEntry& e = pack.getEntry(i);
+    min_length = std::min(min_length, e.solution_length);
+    max_length = std::max(max_length, e.solution_length);
+    total_length += e.solution_length;
+    total_dead_ends += e.dead_ends;
+  }
+  const int count = std::max(1, pack.getMazeCount());
+  std::printf("%d mazes\n", pack.getMazeCount());
+  std::printf("solution length: min %u, mean %.1f, max %u\n",
+              pack.getMazeCount() > 0 ? min_length : 0, total_length / count, max_length);
+  std::printf("dead ends: mean %.1f\n", total_dead_ends / count);
+  return 0;
+}
+
+int verify(const MazePack& pack, int threads) {
+  const std::unique_ptr<ThreadPool> pool = createThreadPool(threads);
+  std::atomic<int> mismatches{0};
+  auto verifyMazes = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const MazePackView maze = pack.getMaze(i);
+      MazeGrid grid(maze.entry->cols, maze.entry->rows);
+      generateSeededMaze(grid, static_cast<GenerationAlgorithm>(maze.entry->algorithm),
+                         maze.entry->seed);
+      MazePackEntry stats = *maze.entry;
+      computeMazePackStats(grid, stats);
+
+      bool same = stats.solution_length == maze.entry->solution_length &&
+                  stats.solution_turns == maze.entry->solution_turns &&
+                  stats.dead_ends == maze.entry->dead_ends &&
+                  stats.junctions == maze.entry->junctions;
+      for (int cell = 0; same && cell < grid.getCellCount(); ++cell) {
+        same = grid.getWalls(cell) == maze.getWalls(cell);
+      }
+      if (!same) {
+        std::fprintf(stderr, "Maze %d (seed %u) does not match\n", i, maze.entry->seed);
+        mismatches++;
+      }
+    }
+  };
+  if (pool && pool->getThreadCount() > 0) {
+    pool->parallelFor(pack.getMazeCount(), verifyMazes);
+  } else {
+    verifyMazes(0, pack.getMazeCount());
+  }
+  std::printf("%d mazes verified, %d mismatched\n", pack.getMazeCount(), mismatches.load());
+  return mismatches == 0 ? 0 : 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if (std::strcmp(argv[1], "generate") == 0) return generate(argc, argv);
+
+  const bool list = argc == 4 && std::strcmp(argv[3], "--list") == 0;
+  const bool has_threads = argc == 5 && std::strcmp(argv[3], "--threads") == 0;
+  const bool is_info = std::strcmp(argv[1], "info") == 0 && (argc == 3 || list);
+  const bool is_verify = std::strcmp(argv[1], "verify") == 0 && (argc == 3 || has_threads);
+  if (!is_info && !is_verify) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  const Clock::time_point start = Clock::now();
+  MazePack pack;
+  if (!pack.open(argv[2])) {
+    std::fprintf(stderr, "%s is not a maze pack\n", argv[2]);
+    return 1;
+  }
+  const double open_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  if (!list) std::printf("Opened %s in %.0f us\n", argv[2], open_us);
+
+  return is_info ? info(pack, list) : verify(pack, has_threads ? std::atoi(argv[4]) : 0);
+}
@@ -0,0 +1,109 @@
+#include "player-physics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Component of a vector by axis index
+static float& axisOf(Vec3& v, int axis) { return axis == 0 ? v.x : axis == 1 ? v.y : v.z; }
+static float axisOf(const Vec3& v, int axis) { return axis == 0 ? v.x : axis == 1 ? v.y : v.z; }
+
+PlayerPhysics::PlayerPhysics(const Vec3& start, const BoxSize3D& size)
+    : size(size), position(start), previous_position(start) {}
+
+AABB PlayerPhysics::getBox(const Vec3& at) const {
+  return {{at.x - size.width / 2, at.y, at.z - size.depth / 2},
+          {at.x + size.width / 2, at.y + size.height, at.z + size.depth / 2}};
+}
+
+AABB PlayerPhysics::getReach(float frame_time, const PlayerInput& input) const {
+  const float time = std::min(frame_time, MAX_FRAME_TIME) + STEP;
+  const float horizontal = (std::fabs(input.velocity.x) + std::fabs(input.velocity.z)) * time;
+  const float vertical = (std::fabs(vertical_speed) + JUMP_SPEED + GRAVITY * time) * time;
+  AABB box = getBox(position);
+  box.min = {box.min.x - horizontal, box.min.y - vertical, box.min.z - horizontal};
+  box.max = {box.max.x + horizontal, box.max.y + vertical, box.max.z + horizontal};
+  return box;
+}
+
+int PlayerPhysics::update(float frame_time, const PlayerInput& input,
+                          const std::vector<AABB>& floors, const std::vector<AABB>& walls) {
+  accumulator += std::min(frame_time, MAX_FRAME_TIME);
+  landed = false;
+  hit_wall = false;
+
+  // a jump is kept until a step runs, so frames without a step do not lose it
+  pending_jump = pending_jump || input.jump;
+  int steps = 0;
+  PlayerInput step_input = input;
+  while (accumulator >= STEP) {
+    previous_position = position;
+    step_input.jump = pending_jump;
+    step(step_input, floors, walls);
+    pending_jump = false;  // one jump per request at most
+    accumulator -= STEP;
+    steps++;
+  }
+  return steps;
+}
+
+void PlayerPhysics::step(const PlayerInput& input, const std::vector<AABB>& floors,
+                         const std::vector<AABB>& walls) {
+  if (input.jump && grounded) {
+    vertical_speed = JUMP_SPEED;
+    grounded = false;
+  }
+
+  // horizontal axes one at a time: a blocked axis stops while the other keeps sliding
+  if (sweepAxis(0, input.velocity.x * STEP, walls)) hit_wall = true;
+  if (sweepAxis(2, input.velocity.z * STEP, walls)) hit_wall = true;
+
+  vertical_speed -= GRAVITY * STEP;
+  const bool was_grounded = grounded;
+  const bool blocked = sweepAxis(1, vertical_speed * STEP, floors);
+  grounded = blocked && vertical_speed < 0.0f;
+  if (blocked) vertical_speed = 0.0f;
+  if (grounded && !was_grounded) landed = true;
+}
+
+bool PlayerPhysics::sweepAxis(int axis, float distance, const std::vector<AABB>& boxes) {
+  if (distance == 0.0f) return false;
+
+  const AABB player = getBox(position);
+  float allowed = distance;
+  bool blocked = false;
+  for (const AABB& box : boxes) {
+    // only boxes overlapping on the two other axes can be hit
+    bool overlap = true;
+    for (int other = 0; other < 3 && overlap; ++other) {
+      if (other == axis) continue;
+      overlap = axisOf(player.min, other) < axisOf(box.max, other) &&
+                axisOf(player.max, other) > axisOf(box.min, other);
+    }
+    if (!overlap) continue;
+
+    // boxes the player already penetrates are ignored, so it can always move out of them
+    if (distance > 0.0f) {
+      const float gap = axisOf(box.min, axis) - axisOf(player.max, axis);
+      if (gap >= -SKIN && gap - SKIN < allowed) {
+        allowed = std::max(0.0f, gap - SKIN);
+        blocked = true;
+      }
+    } else {
+      const float gap = axisOf(box.max, axis) - axisOf(player.min, axis);
+      if (gap <= SKIN && gap + SKIN > allowed) {
+        allowed = std::min(0.0f, gap + SKIN);
+        blocked = true;
+      }
+    }
+  }
+
+  axisOf(position, axis) += allowed;
+  return blocked;
+}
+
+Vec3 PlayerPhysics::getInterpolatedPosition() const {
+  const float alpha = accumulator / STEP;
+  return {previous_position.x + (position.x - previous_position.x) * alpha,
+          previous_position.y + (position.y - previous_position.y) * alpha,
+          previous_position.z + (position.z - previous_position.z) * alpha};
+}
@@ -0,0 +1,65 @@
+/*
+Player Physics - Fixed-timestep movement with swept AABB collision
+
+The player advances in fixed steps (240 Hz) whatever the frame rate, so movement is deterministic
+and cannot tunnel through thin walls. Each step sweeps the player box one axis at a time and stops
+it at the first box in the way, which lets it slide along walls. The rendered position is
+interpolated between the last two steps.
+*/
+#pragma once
+
+#include <vector>
+
+#include "utils/types.hpp"
+
+// Movement requested for a frame; constant over all the steps of that frame
+struct PlayerInput {
+  Vec3 velocity = {0.0f, 0.0f, 0.0f};  // horizontal walking velocity (y is ignored)
+  bool jump = false;                   // start a jump if standing on the floor
+};
+
+// PlayerPhysics class integrating the player's movement at a fixed rate
+class PlayerPhysics {
+ public:
+  static constexpr float STEP = 1.0f / 240.0f;      // seconds per physics step
+  static constexpr float MAX_FRAME_TIME = 0.25f;    // longer frames are cut (no spiral of death)
+  static constexpr float GRAVITY = 9.81f;           // downwards acceleration
+  static constexpr float JUMP_SPEED = 5.0f;         // upwards speed at the start of a jump
+  static constexpr float SKIN = 0.001f;             // gap kept between the player and boxes
+
+ private:
+  BoxSize3D size;                 // player box; the position is the center of its bottom face
+  Vec3 position;                  // position after the last step
+  Vec3 previous_position;         // position after the step before
+  float vertical_speed = 0.0f;    // upwards speed
+  bool grounded = false;          // standing on a floor box
+  bool landed = false;            // touched the floor during the last update
+  bool hit_wall = false;          // was stopped by a wall during the last update
+  float accumulator = 0.0f;       // frame time not yet consumed by steps
+  bool pending_jump = false;      // jump requested but not consumed by a step yet
+
+  // Run one fixed step
+  void step(const PlayerInput& input, const std::vector<AABB>& floors,
+            const std::vector<AABB>& walls);
+  // Move along one axis (0: x, 1: y, 2: z) as far as the boxes allow; returns true if blocked
+  bool sweepAxis(int axis, float distance, const std::vector<AABB>& boxes);
+
+ public:
+  PlayerPhysics(const Vec3& start, const BoxSize3D& size);
+
+  // Box of the player at a position
+  AABB getBox(const Vec3& at) const;
+  // Region the player can reach within a frame, to gather the boxes for update()
+  AABB getReach(float frame_time, const PlayerInput& input) const;
+  // Consume the frame time in fixed steps against the given floor and wall boxes; returns the
+  // number of steps run. A jump requested on a frame too short for a step waits for the next one.
+  int update(float frame_time, const PlayerInput& input, const std::vector<AABB>& floors,
+             const std::vector<AABB>& walls);
+
+  // Position to render, interpolated between the last two steps
+  Vec3 getInterpolatedPosition() const;
+  const Vec3& getPosition() const { return position; }
+  bool isGrounded() const { return grounded; }
+  bool hasLanded() const { return landed; }
+  bool hasHitWall() const { return hit_wall; }
+};
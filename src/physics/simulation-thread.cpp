@@ -0,0 +1,125 @@
+#include "simulation-thread.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const SimulationThread::Clock::duration TICK_DURATION =
+    std::chrono::duration_cast<SimulationThread::Clock::duration>(
+        std::chrono::duration<double>(SimulationThread::TICK));
+
+Vec3 lerp(const Vec3& from, const Vec3& to, float t) {
+  return {from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t,
+          from.z + (to.z - from.z) * t};
+}
+
+}  // namespace
+
+SimulationThread::SimulationThread(const Vec3& start, const BoxSize3D& size, GatherBoxes gather,
+                                   TelemetryRecorder* telemetry)
+    : physics(start, size), gather(std::move(gather)), telemetry(telemetry) {
+  state.position = start;
+  state.time = Clock::now();
+  snapshots[0] = state;
+  snapshots[1] = state;
+}
+
+void SimulationThread::start() {
+  if (isRunning()) return;
+  running = true;
+  thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+  running = false;
+  if (thread.joinable()) thread.join();
+}
+
+void SimulationThread::setInput(const SimulationInput& frame_input) {
+  std::lock_guard<std::mutex> lock(input_mutex);
+  input = frame_input;
+}
+
+PlayerSnapshot SimulationThread::getSnapshot() const {
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  return snapshots[latest];
+}
+
+Vec3 SimulationThread::getInterpolatedPosition(Clock::time_point now) const {
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  const PlayerSnapshot& previous = snapshots[latest ^ 1];
+  const PlayerSnapshot& current = snapshots[latest];
+  if (current.time <= previous.time) return current.position;
+
+  // show the state of one tick ago: from the previous snapshot to the latest over a tick
+  const float t = std::chrono::duration<float>(now - current.time).count() / TICK;
+  return lerp(previous.position, current.position, std::clamp(t, 0.0f, 1.0f));
+}
+
+void SimulationThread::run() {
+  Clock::time_point due = Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    snapshots[0].time = snapshots[1].time = due;
+  }
+
+  while (running) {
+    due += TICK_DURATION;
+    std::this_thread::sleep_until(due);
+
+    // after a stall, catch up at most MAX_LATE_TICKS ticks and drop the rest
+    const Clock::time_point now = Clock::now();
+    if (now - due > MAX_LATE_TICKS * TICK_DURATION) due = now - MAX_LATE_TICKS * TICK_DURATION;
+
+    SimulationInput tick_input;
+    {
+      std::lock_guard<std::mutex> lock(input_mutex);
+      tick_input = input;
+    }
+    if (!tick(tick_input, due)) continue;
+
+    // publish into the older buffer, which becomes the latest
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    latest ^= 1;
+    snapshots[latest] = state;
+  }
+}
+
+bool SimulationThread::tick(const SimulationInput& tick_input, Clock::time_point due) {
+  PlayerInput player_input;
+  player_input.velocity = tick_input.velocity;
+  player_input.jump = tick_input.jumps != jumps_done;
+
+  // gathered once per step, as the telemetry replay does
+  const AABB reach = physics.getReach(TICK, player_input);
+  floors.clear();
+  walls.clear();
+  if (!gather(physics.getPosition(), reach, floors, walls)) return false;
+  jumps_done = tick_input.jumps;
+
+  physics.update(TICK, player_input, floors, walls);
+
+  if (telemetry && telemetry->isRecording()) {
+    TelemetrySample sample;
+    sample.frame = static_cast<uint32_t>(state.tick);
+    sample.frame_time = TICK;
+    sample.velocity = player_input.velocity;
+    sample.position = physics.getPosition();
+    sample.yaw = tick_input.yaw;
+    sample.pitch = tick_input.pitch;
+    sample.keys = tick_input.keys;
+    sample.events = (player_input.jump ? EVENT_JUMP : 0) |
+                    (physics.hasLanded() ? EVENT_LANDED : 0) |
+                    (physics.hasHitWall() ? EVENT_HIT_WALL : 0) |
+                    (physics.isGrounded() ? EVENT_GROUNDED : 0);
+    telemetry->record(sample);
+  }
+
+  state.tick++;
+  state.time = due;
+  state.position = physics.getPosition();
+  state.grounded = physics.isGrounded();
+  if (physics.hasLanded()) state.landings++;
+  return true;
+}
@@ -0,0 +1,97 @@
+/*
+Simulation Thread - Fixed-rate player simulation beside the render loop
+
+The player physics, its collision queries and the telemetry run on their own thread, one physics
+step per tick, paced by the clock instead of the frame rate: a slow frame delays neither the
+physics nor the input it reads. The render thread hands over its latest input and reads the two
+latest snapshots, double-buffered behind a short lock, interpolating between them for display.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "physics/player-physics.hpp"
+#include "telemetry/telemetry-recorder.hpp"
+
+// Input from the render thread; the latest one drives every tick until the next one arrives
+struct SimulationInput {
+  Vec3 velocity = {0.0f, 0.0f, 0.0f};  // horizontal walking velocity (y is ignored)
+  uint32_t jumps = 0;                  // jump presses so far; each new press starts one jump
+  float yaw = 0.0f;                    // camera orientation, for the telemetry
+  float pitch = 0.0f;
+  uint16_t keys = 0;                   // TelemetryKey bits held
+};
+
+// Player state at the end of a tick
+struct PlayerSnapshot {
+  uint64_t tick = 0;                           // ticks run so far
+  std::chrono::steady_clock::time_point time;  // when the tick was due
+  Vec3 position = {0.0f, 0.0f, 0.0f};          // physics position
+  bool grounded = false;                       // standing on the floor
+  uint32_t landings = 0;                       // landings so far, so no frame misses one
+};
+
+// SimulationThread class stepping the player physics at a fixed rate on its own thread
+class SimulationThread {
+ public:
+  using Clock = std::chrono::steady_clock;
+  // Gather the floor and wall boxes within reach of the player; returns false while the ground
+  // under the player is not there yet, which skips the tick (the player waits). Runs on the
+  // simulation thread.
+  using GatherBoxes = std::function<bool(const Vec3& position, const AABB& reach,
+                                         std::vector<AABB>& floors, std::vector<AABB>& walls)>;
+
+  static constexpr float TICK = PlayerPhysics::STEP;  // seconds per tick, one physics step each
+  // ticks caught up back to back after a stall; the time beyond is dropped
+  static constexpr int MAX_LATE_TICKS = static_cast<int>(PlayerPhysics::MAX_FRAME_TIME / TICK);
+
+ private:
+  PlayerPhysics physics;              // owned by the simulation thread while it runs
+  GatherBoxes gather;                 // collision boxes around the player
+  TelemetryRecorder* telemetry;       // records every tick while recording, or null
+  std::vector<AABB> floors;           // boxes within reach this tick
+  std::vector<AABB> walls;
+  uint32_t jumps_done = 0;            // jump presses already turned into jumps
+  PlayerSnapshot state;               // snapshot being built by the simulation thread
+
+  std::mutex input_mutex;             // guards input
+  SimulationInput input;              // latest input of the render thread
+  mutable std::mutex snapshot_mutex;  // guards snapshots and latest
+  PlayerSnapshot snapshots[2];        // the two latest ticks
+  int latest = 0;                     // index of the latest snapshot
+  std::atomic<bool> running{false};   // the thread keeps ticking
+  std::thread thread;                 // simulation thread
+
+  // Body of the simulation thread
+  void run();
+  // Run one tick due at the given time; false if it was skipped
+  bool tick(const SimulationInput& tick_input, Clock::time_point due);
+
+ public:
+  SimulationThread(const Vec3& start, const BoxSize3D& size, GatherBoxes gather,
+                   TelemetryRecorder* telemetry = nullptr);
+  ~SimulationThread() { stop(); }
+
+  SimulationThread(const SimulationThread&) = delete;
+  SimulationThread& operator=(const SimulationThread&) = delete;
+
+  // Start ticking from now; the recorder, if any, must be started first
+  void start();
+  // Stop ticking and join the thread
+  void stop();
+  bool isRunning() const { return thread.joinable(); }
+
+  // Hand over the input of a frame (render thread)
+  void setInput(const SimulationInput& frame_input);
+  // Get the latest snapshot (render thread)
+  PlayerSnapshot getSnapshot() const;
+  // Position to render at a time, interpolated between the two latest snapshots; lags one tick
+  // behind so that it never extrapolates (render thread)
+  Vec3 getInterpolatedPosition(Clock::time_point now) const;
+};
@@ -13,6 +13,7 @@ class Player {
   Player(Vector3 initialPos);
 
   const Vector3& getPos() const { return position; }
+  const BoxSize3D& getDimensions() const { return dimensions; }
   const BoundingBox& getBBox() const { return bbox; }
 
   void setPos(const Vector3& newPos);
@@ -0,0 +1,127 @@
+#include "frame-profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+thread_local FrameProfiler* FrameProfiler::attached = nullptr;
+
+const char* getPhaseName(ProfilePhase phase) {
+  switch (phase) {
+    case ProfilePhase::AUDIO:
+      return "audio";
+    case ProfilePhase::WORLD:
+      return "world";
+    case ProfilePhase::INPUT:
+      return "input";
+    case ProfilePhase::CAMERA:
+      return "camera";
+    case ProfilePhase::GENERATION:
+      return "generation";
+    case ProfilePhase::MAZE_PATH:
+      return "maze_path";
+    case ProfilePhase::MAZE_FLOW_FIELD:
+      return "maze_flow_field";
+    case ProfilePhase::MAZE_BOUNDS:
+      return "maze_bounds";
+    case ProfilePhase::DRAW_3D:
+      return "draw_3d";
+    case ProfilePhase::DRAW_2D:
+      return "draw_2d";
+    case ProfilePhase::PRESENT:
+      return "present";
+    default:
+      return "unknown";
+  }
+}
+
+FrameProfiler::~FrameProfiler() {
+  if (attached == this) attached = nullptr;
+}
+
+void FrameProfiler::setEnabled(bool enable) {
+  enabled = enable;
+  // a frame started while disabled is not recorded
+  if (!enabled) in_frame = false;
+}
+
+void FrameProfiler::beginFrame() {
+  if (!enabled) return;
+  current = {};
+  frame_start = Clock::now();
+  in_frame = true;
+}
+
+void FrameProfiler::endFrame() {
+  if (!in_frame) return;
+  current.total = std::chrono::duration<float, std::milli>(Clock::now() - frame_start).count();
+  frames[next] = current;
+  next = (next + 1) % HISTORY;
+  recorded = std::min(recorded + 1, HISTORY);
+  frame_index++;
+  in_frame = false;
+}
+
+PhaseStats FrameProfiler::getColumnStats(int phase) const {
+  PhaseStats stats;
+  if (recorded == 0) return stats;
+
+  std::array<float, HISTORY> samples;
+  for (int i = 0; i < recorded; ++i) {
+    samples[i] = phase < 0 ? frames[i].total : frames[i].phases[phase];
+    stats.mean += samples[i];
+    stats.max = std::max(stats.max, samples[i]);
+  }
+  stats.mean /= recorded;
+
+  // nearest-rank percentiles; p50 first, then p99 within the upper part
+  const int p50 = (recorded - 1) / 2;
+  const int p99 = (recorded - 1) * 99 / 100;
+  std::nth_element(samples.begin(), samples.begin() + p50, samples.begin() + recorded);
+  stats.p50 = samples[p50];
+  std::nth_element(samples.begin() + p50, samples.begin() + p99, samples.begin() + recorded);
+  stats.p99 = samples[p99];
+  return stats;
+}
+
+bool FrameProfiler::writeCsv(const std::string& file_name) const {
+  FILE* file = std::fopen(file_name.c_str(), "w");
+  if (!file) return false;
+
+  std::fprintf(file, "frame,total_ms");
+  for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+    std::fprintf(file, ",%s_ms", getPhaseName(static_cast<ProfilePhase>(p)));
+  }
+  std::fprintf(file, "\n");
+
+  // the oldest frame is at next once the ring has wrapped
+  const int first = recorded < HISTORY ? 0 : next;
+  for (int i = 0; i < recorded; ++i) {
+    const FrameTimes& frame = frames[(first + i) % HISTORY];
+    std::fprintf(file, "%lld,%.4f", frame_index - recorded + i, frame.total);
+    for (const float time : frame.phases) std::fprintf(file, ",%.4f", time);
+    std::fprintf(file, "\n");
+  }
+  std::fclose(file);
+  return true;
+}
+
+bool FrameProfiler::writeJson(const std::string& file_name) const {
+  FILE* file = std::fopen(file_name.c_str(), "w");
+  if (!file) return false;
+
+  const auto writeStats = [&](const char* name, const PhaseStats& s, const char* end) {
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"p50_ms\": %.4f, \"p99_ms\": %.4f, \"mean_ms\": %.4f, "
+                 "\"max_ms\": %.4f}%s\n",
+                 name, s.p50, s.p99, s.mean, s.max, end);
+  };
+  std::fprintf(file, "{\n  \"frames\": %d,\n  \"phases\": [\n", recorded);
+  writeStats("frame", getFrameStats(), ",");
+  for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+    const ProfilePhase phase = static_cast<ProfilePhase>(p);
+    writeStats(getPhaseName(phase), getPhaseStats(phase), p + 1 < PROFILE_PHASE_COUNT ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  std::fclose(file);
+  return true;
+}
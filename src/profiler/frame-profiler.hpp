@@ -0,0 +1,139 @@
+/*
+Frame Profiler - Per-phase frame timings
+
+Scoped timers add the time spent in each phase of a frame (input, generation, camera, drawing,
+...) to the frame being recorded. Finished frames go to a ring buffer of the last HISTORY frames,
+from which p50/p99 are computed for the overlay and the CSV/JSON dumps.
+
+Timers only record on the thread the profiler is attached to (the main loop); on other threads,
+or while the profiler is disabled, a timer is a thread-local load and a branch. Building without
+NEUROPATH_PROFILING compiles the timers out entirely.
+*/
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Phases of a frame; nested phases (the maze ones) are also counted in the phase around them
+enum class ProfilePhase : uint8_t {
+  AUDIO,            // music streaming
+  WORLD,            // endless world chunk streaming
+  INPUT,            // keyboard polling and walking velocity
+  CAMERA,           // camera update and placement
+  GENERATION,       // applying maze generation steps
+  MAZE_PATH,        // path to the exit, once the maze is complete
+  MAZE_FLOW_FIELD,  // flow field to the exit, once the maze is complete
+  MAZE_BOUNDS,      // collision boxes, once the maze is complete
+  DRAW_3D,          // 3D scene submission
+  DRAW_2D,          // 2D maze and text
+  PRESENT,          // swapping buffers, including the wait for the target frame rate
+  COUNT
+};
+constexpr int PROFILE_PHASE_COUNT = static_cast<int>(ProfilePhase::COUNT);
+
+// Get the display name of a phase
+const char* getPhaseName(ProfilePhase phase);
+
+// Distribution of a timing over the recorded frames, in milliseconds
+struct PhaseStats {
+  float p50 = 0.0f;
+  float p99 = 0.0f;
+  float mean = 0.0f;
+  float max = 0.0f;
+};
+
+// FrameProfiler class recording phase timings per frame
+class FrameProfiler {
+ public:
+  static constexpr int HISTORY = 512;  // frames kept in the ring buffer
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  // Timings of one frame, in milliseconds
+  struct FrameTimes {
+    float total;
+    std::array<float, PROFILE_PHASE_COUNT> phases;
+  };
+
+  std::array<FrameTimes, HISTORY> frames;  // ring buffer of finished frames
+  FrameTimes current = {};                 // frame being recorded
+  Clock::time_point frame_start;           // start of the frame being recorded
+  int next = 0;                            // ring slot of the next finished frame
+  int recorded = 0;                        // finished frames in the ring (at most HISTORY)
+  long long frame_index = 0;               // finished frames since the start
+  bool enabled = false;                    // recording
+  bool in_frame = false;                   // between beginFrame() and endFrame()
+
+  static thread_local FrameProfiler* attached;  // profiler of the calling thread, if any
+
+  // Stats of one column of the ring (-1 for the frame totals)
+  PhaseStats getColumnStats(int phase) const;
+
+ public:
+  FrameProfiler() = default;
+  ~FrameProfiler();
+
+  FrameProfiler(const FrameProfiler&) = delete;
+  FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+  // Make the timers of the calling thread record into this profiler
+  void attachToThread() { attached = this; }
+  // Profiler the timers of the calling thread record into, or null
+  static FrameProfiler* getAttached() { return attached; }
+
+  // Start or stop recording; frames recorded so far are kept
+  void setEnabled(bool enable);
+  bool isEnabled() const { return enabled; }
+
+  // Start and finish the frame of the main loop
+  void beginFrame();
+  void endFrame();
+  // Add time spent in a phase to the current frame
+  void addTime(ProfilePhase phase, Clock::duration time) {
+    if (in_frame) {
+      current.phases[static_cast<int>(phase)] +=
+          std::chrono::duration<float, std::milli>(time).count();
+    }
+  }
+
+  int getRecordedFrames() const { return recorded; }
+  PhaseStats getPhaseStats(ProfilePhase phase) const {
+    return getColumnStats(static_cast<int>(phase));
+  }
+  PhaseStats getFrameStats() const { return getColumnStats(-1); }
+
+  // Write every recorded frame, one row per frame, oldest first; returns false on failure
+  bool writeCsv(const std::string& file_name) const;
+  // Write the stats of every phase; returns false on failure
+  bool writeJson(const std::string& file_name) const;
+};
+
+// ScopedPhase class adding the time until the end of its scope to a phase
+class ScopedPhase {
+  FrameProfiler* profiler;
+  ProfilePhase phase;
+  FrameProfiler::Clock::time_point start;
+
+ public:
+  explicit ScopedPhase(ProfilePhase phase) : profiler(FrameProfiler::getAttached()), phase(phase) {
+    if (profiler && !profiler->isEnabled()) profiler = nullptr;
+    if (profiler) start = FrameProfiler::Clock::now();
+  }
+  ~ScopedPhase() {
+    if (profiler) profiler->addTime(phase, FrameProfiler::Clock::now() - start);
+  }
+
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+};
+
+// Time the rest of the enclosing scope as a phase
+#if defined(NEUROPATH_PROFILING)
+#define PROFILE_PHASE_CONCAT_(a, b) a##b
+#define PROFILE_PHASE_NAME_(line) PROFILE_PHASE_CONCAT_(profile_phase_, line)
+#define PROFILE_PHASE(phase) ScopedPhase PROFILE_PHASE_NAME_(__LINE__)(phase)
+#else
+#define PROFILE_PHASE(phase) ((void)0)
+#endif
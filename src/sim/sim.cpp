@@ -0,0 +1,193 @@
+/*
+NeuroPath headless bot simulation
+
+Runs random walkers, wall followers and noisy shortest-path bots through many generated mazes
+on all cores, without opening a window. Prints solve-time and path-length distributions per
+bot kind and the simulation throughput, and writes them as JSON.
+
+Usage: neuropath_sim [--mazes N] [--agents N] [--size WxH] [--algorithm NAME] [--seed N]
+                     [--max-seconds S] [--noise P] [--threads N] [--json FILE]
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "physics/player-physics.hpp"
+#include "simulation/simulation.hpp"
+
+namespace {
+
+// Distribution of one measure over a set of episodes
+struct Distribution {
+  double p10 = 0.0;
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double mean = 0.0;
+};
+
+// Summary of one bot kind
+struct KindSummary {
+  AgentKind kind;
+  int episodes = 0;
+  int solved = 0;
+  Distribution solve_seconds;  // simulated time to the exit, solved episodes only
+  Distribution path_moves;     // cells walked, solved episodes only
+  Distribution path_ratio;     // cells walked over the shortest path, solved episodes only
+};
+
+// Nearest-rank percentiles of a set of samples
+Distribution distributionOf(std::vector<double>& samples) {
+  Distribution d;
+  if (samples.empty()) return d;
+  std::sort(samples.begin(), samples.end());
+  const auto rank = [&](double p) {
+    const std::size_t i = static_cast<std::size_t>(p * (samples.size() - 1) + 0.5);
+    return samples[i];
+  };
+  d.p10 = rank(0.10);
+  d.p50 = rank(0.50);
+  d.p90 = rank(0.90);
+  d.p99 = rank(0.99);
+  for (const double s : samples) d.mean += s;
+  d.mean /= samples.size();
+  return d;
+}
+
+std::vector<KindSummary> summarize(const SimulationReport& report) {
+  std::vector<KindSummary> summaries;
+  for (int k = 0; k < AGENT_KIND_COUNT; ++k) {
+    KindSummary summary;
+    summary.kind = static_cast<AgentKind>(k);
+    std::vector<double> seconds, moves, ratios;
+    for (const EpisodeResult& e : report.episodes) {
+      if (e.kind != summary.kind) continue;
+      summary.episodes++;
+      if (!e.solved) continue;
+      summary.solved++;
+      seconds.push_back(e.steps * PlayerPhysics::STEP);
+      moves.push_back(e.moves);
+      ratios.push_back(e.optimal_moves > 0 ? static_cast<double>(e.moves) / e.optimal_moves : 1.0);
+    }
+    summary.solve_seconds = distributionOf(seconds);
+    summary.path_moves = distributionOf(moves);
+    summary.path_ratio = distributionOf(ratios);
+    summaries.push_back(summary);
+  }
+  return summaries;
+}
+
+void printDistribution(const char* name, const Distribution& d) {
+  std::printf("  %-14s %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, d.p10, d.p50, d.p90, d.p99,
+              d.mean);
+}
+
+void writeDistribution(FILE* file, const char* name, const Distribution& d, const char* end) {
+  std::fprintf(file,
+               "      \"%s\": {\"p10\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, "
+               "\"mean\": %.3f}%s\n",
+               name, d.p10, d.p50, d.p90, d.p99, d.mean, end);
+}
+
+bool writeJson(const std::string& file_name, const SimulationConfig& config,
+               const SimulationReport& report, const std::vector<KindSummary>& summaries) {
+  FILE* file = std::fopen(file_name.c_str(), "w");
+  if (!file) return false;
+
+  std::fprintf(file,
+               "{\n  \"mazes\": %d, \"agents_per_kind\": %d, \"cols\": %d, \"rows\": %d, "
+               "\"algorithm\": \"%s\", \"seed\": %u,\n",
+               config.mazes, config.agents_per_kind, config.cols, config.rows,
+               getAlgorithmName(config.algorithm), config.seed);
+  std::fprintf(file,
+               "  \"total_steps\": %lld, \"wall_seconds\": %.3f, \"steps_per_second\": %.0f,\n",
+               report.total_steps, report.wall_seconds, report.getStepsPerSecond());
+  std::fprintf(file, "  \"agents\": [\n");
+  for (std::size_t i = 0; i < summaries.size(); ++i) {
+    const KindSummary& s = summaries[i];
+    std::fprintf(file, "    {\"kind\": \"%s\", \"episodes\": %d, \"solved\": %d,\n",
+                 getAgentName(s.kind), s.episodes, s.solved);
+    writeDistribution(file, "solve_seconds", s.solve_seconds, ",");
+    writeDistribution(file, "path_moves", s.path_moves, ",");
+    writeDistribution(file, "path_ratio", s.path_ratio, "");
+    std::fprintf(file, "    }%s\n", i + 1 < summaries.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  std::fclose(file);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  SimulationConfig config;
+  int threads = 0;
+  std::string json_file = "sim_results.json";
+
+  for (int i = 1; i < argc; ++i) {
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--mazes") == 0 && has_value) {
+      config.mazes = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--agents") == 0 && has_value) {
+      config.agents_per_kind = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--size") == 0 && has_value &&
+               std::sscanf(argv[i + 1], "%dx%d", &config.cols, &config.rows) == 2 &&
+               config.cols > 0 && config.rows > 0 && (config.cols > 1 || config.rows > 1)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--algorithm") == 0 && has_value &&
+               parseAlgorithmName(argv[i + 1], config.algorithm)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+      config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--max-seconds") == 0 && has_value) {
+      config.max_seconds = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--noise") == 0 && has_value) {
+      config.noise = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--threads") == 0 && has_value) {
+      threads = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--json") == 0 && has_value) {
+      json_file = argv[++i];
+    } else {
+      std::fprintf(stderr,
+                   "Usage: %s [--mazes N] [--agents N] [--size WxH] [--algorithm NAME] "
+                   "[--seed N] [--max-seconds S] [--noise P] [--threads N] [--json FILE]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  // the calling thread runs a share of the work too
+  const std::unique_ptr<ThreadPool> pool = createThreadPool(threads);
+  const int thread_count = pool ? pool->getThreadCount() + 1 : 1;
+  std::printf("Simulating %d bots in %d %dx%d %s mazes on %d thread%s\n",
+              config.mazes * config.agents_per_kind * AGENT_KIND_COUNT, config.mazes,
+              config.cols, config.rows, getAlgorithmName(config.algorithm), thread_count,
+              thread_count > 1 ? "s" : "");
+
+  const SimulationReport report = runSimulation(config, pool.get());
+  const std::vector<KindSummary> summaries = summarize(report);
+
+  for (const KindSummary& s : summaries) {
+    std::printf("\n%s: %d/%d solved\n", getAgentName(s.kind), s.solved, s.episodes);
+    std::printf("  %-14s %10s %10s %10s %10s %10s\n", "", "p10", "p50", "p90", "p99", "mean");
+    printDistribution("solve seconds", s.solve_seconds);
+    printDistribution("path cells", s.path_moves);
+    std::printf("  %-14s %10.2f %10.2f %10.2f %10.2f %10.2f\n", "path / optimal",
+                s.path_ratio.p10, s.path_ratio.p50, s.path_ratio.p90, s.path_ratio.p99,
+                s.path_ratio.mean);
+  }
+  std::printf("\n%lld steps in %.2f s: %.0f simulated steps/s\n", report.total_steps,
+              report.wall_seconds, report.getStepsPerSecond());
+
+  if (!writeJson(json_file, config, report, summaries)) {
+    std::fprintf(stderr, "Failed to write %s\n", json_file.c_str());
+    return 1;
+  }
+  std::printf("Results written to %s\n", json_file.c_str());
+  return 0;
+}
@@ -0,0 +1,175 @@
+#include "simulation.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "maze-generator/maze-generator.hpp"
+#include "physics/player-physics.hpp"
+
+namespace {
+
+const BoxSize3D PLAYER_SIZE = {0.3f, 1.0f, 0.3f};  // same box as the game's player
+constexpr float ARRIVAL_DISTANCE = 0.05f;          // distance counting as at a cell center
+
+// Seed of one episode, mixed from the run seed and the episode indices
+uint32_t episodeSeed(uint32_t seed, int maze, int kind, int agent) {
+  uint64_t h = (static_cast<uint64_t>(seed) << 32) ^ (static_cast<uint64_t>(maze) << 8) ^
+               (static_cast<uint64_t>(kind) << 4) ^ static_cast<uint64_t>(agent) << 40;
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return static_cast<uint32_t>(h ^ (h >> 31));
+}
+
+// Pick a random direction without a wall
+int randomOpenDirection(const MazeGrid& grid, int cell, std::mt19937& rng) {
+  int candidates[4];
+  int count = 0;
+  for (int dir = TOP; dir <= LEFT; ++dir) {
+    if (!grid.hasWall(cell, dir)) candidates[count++] = dir;
+  }
+  return candidates[std::uniform_int_distribution<>(0, count - 1)(rng)];
+}
+
+// Choose the direction of the next cell to walk to
+int chooseDirection(AgentKind kind, const MazeGenerator& maze, int cell, int& heading,
+                    float noise, std::mt19937& rng) {
+  const MazeGrid& grid = maze.getGrid();
+  switch (kind) {
+    case AgentKind::WALL_FOLLOWER:
+      // right hand on the wall: try right, straight, left, then turn back
+      for (const int turn : {1, 0, 3, 2}) {
+        const int dir = (heading + turn) & 3;
+        if (!grid.hasWall(cell, dir)) {
+          heading = dir;
+          return dir;
+        }
+      }
+      return heading;
+    case AgentKind::NOISY_OPTIMAL:
+      if (std::uniform_real_distribution<float>(0.0f, 1.0f)(rng) >= noise) {
+        return maze.getFlowField().getDirection(cell);
+      }
+      return randomOpenDirection(grid, cell, rng);
+    default:
+      return randomOpenDirection(grid, cell, rng);
+  }
+}
+
+// Walk one bot from the first cell to the exit
+EpisodeResult runEpisode(const MazeGenerator& maze, AgentKind kind, const SimulationConfig& config,
+                         uint32_t seed) {
+  const MazeGrid& grid = maze.getGrid();
+  const BoxSize3D& cell_size = maze.getFloorDimension();
+  const int goal = grid.getCellCount() - 1;
+  const int max_steps = static_cast<int>(config.max_seconds / PlayerPhysics::STEP);
+  std::mt19937 rng(seed);
+
+  // start standing on the first floor tile
+  PlayerPhysics physics({0.0f, cell_size.height / 2, 0.0f}, PLAYER_SIZE);
+  std::vector<AABB> floors;
+  std::vector<AABB> walls;
+
+  EpisodeResult result = {0, kind, false, 0, 0, maze.getFlowField().getDistance(0)};
+  int cell = 0;
+  int heading = RIGHT;
+  int target = cell;
+  Vec3 target_position = {0.0f, 0.0f, 0.0f};
+  PlayerInput input;
+
+  while (result.steps < max_steps) {
+    if (target == cell) {
+      if (cell == goal) {
+        result.solved = true;
+        break;
+      }
+      const int dir = chooseDirection(kind, maze, cell, heading, config.noise, rng);
+      target = grid.getNeighbor(cell, dir);
+      target_position = {grid.cellX(target) * cell_size.width, 0.0f,
+                         grid.cellY(target) * cell_size.depth};
+
+      // the boxes around both cells cover the whole move
+      const AABB from = physics.getBox(physics.getPosition());
+      const AABB to = physics.getBox(target_position);
+      const AABB reach = {{std::fmin(from.min.x, to.min.x) - 0.5f, -1.0f,
+                           std::fmin(from.min.z, to.min.z) - 0.5f},
+                          {std::fmax(from.max.x, to.max.x) + 0.5f, 2.0f,
+                           std::fmax(from.max.z, to.max.z) + 0.5f}};
+      floors.clear();
+      walls.clear();
+      maze.getFloorIndex().forEachNear(reach, [&](const AABB& box) {
+        floors.push_back(box);
+        return false;
+      });
+      maze.getWallIndex().forEachNear(reach, [&](const AABB& box) {
+        walls.push_back(box);
+        return false;
+      });
+    }
+
+    // walk straight to the target cell center
+    const Vec3& position = physics.getPosition();
+    const float dx = target_position.x - position.x;
+    const float dz = target_position.z - position.z;
+    const float distance = std::sqrt(dx * dx + dz * dz);
+    if (distance < ARRIVAL_DISTANCE) {
+      cell = target;
+      result.moves++;
+      continue;
+    }
+    const float speed = std::fmin(config.move_speed, distance / PlayerPhysics::STEP);
+    input.velocity = {dx / distance * speed, 0.0f, dz / distance * speed};
+    physics.update(PlayerPhysics::STEP, input, floors, walls);
+    result.steps++;
+  }
+  return result;
+}
+
+}  // namespace
+
+const char* getAgentName(AgentKind kind) {
+  switch (kind) {
+    case AgentKind::WALL_FOLLOWER:
+      return "wall follower";
+    case AgentKind::NOISY_OPTIMAL:
+      return "noisy optimal";
+    default:
+      return "random walker";
+  }
+}
+
+SimulationReport runSimulation(const SimulationConfig& config, ThreadPool* pool) {
+  SimulationReport report;
+  const int episodes_per_maze = AGENT_KIND_COUNT * config.agents_per_kind;
+  report.episodes.resize(static_cast<std::size_t>(config.mazes) * episodes_per_maze);
+
+  const auto start = std::chrono::steady_clock::now();
+  auto simulateMazes = [&](int begin, int end) {
+    for (int m = begin; m < end; ++m) {
+      MazeGenerator maze(config.cols, config.rows);
+      maze.setAlgorithm(config.algorithm);
+      maze.setSeed(episodeSeed(config.seed, m, 0xF, 0));
+      maze.finish_generation();
+
+      for (int kind = 0; kind < AGENT_KIND_COUNT; ++kind) {
+        for (int agent = 0; agent < config.agents_per_kind; ++agent) {
+          EpisodeResult result = runEpisode(maze, static_cast<AgentKind>(kind), config,
+                                            episodeSeed(config.seed, m, kind, agent));
+          result.maze = m;
+          report.episodes[static_cast<std::size_t>(m) * episodes_per_maze +
+                          kind * config.agents_per_kind + agent] = result;
+        }
+      }
+    }
+  };
+  if (pool && pool->getThreadCount() > 0) {
+    pool->parallelFor(config.mazes, simulateMazes);
+  } else {
+    simulateMazes(0, config.mazes);
+  }
+  report.wall_seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  for (const EpisodeResult& episode : report.episodes) report.total_steps += episode.steps;
+  return report;
+}
@@ -0,0 +1,64 @@
+/*
+Bot Simulation - Headless batch evaluation of simulated players
+
+Runs bots through generated mazes without a window. Bots move with the same fixed-step player
+physics and collision boxes as the game; they only decide which neighbouring cell to walk to
+next. Mazes are sharded across a thread pool, and every episode is seeded from the run seed, so
+a run is reproducible whatever the number of threads.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/generation-strategy.hpp"
+
+// Kinds of simulated players
+enum class AgentKind {
+  RANDOM_WALKER,  // walks to a random open neighbour at every cell
+  WALL_FOLLOWER,  // keeps its right hand on the wall
+  NOISY_OPTIMAL   // follows the shortest path, with a random detour now and then
+};
+constexpr int AGENT_KIND_COUNT = 3;
+
+// Get the display name of an agent kind
+const char* getAgentName(AgentKind kind);
+
+// Parameters of a simulation run
+struct SimulationConfig {
+  int mazes = 100;                                           // mazes to generate
+  int agents_per_kind = 10;                                  // bots of each kind per maze
+  int cols = 40;                                             // maze width in cells
+  int rows = 20;                                             // maze height in cells
+  GenerationAlgorithm algorithm = GenerationAlgorithm::DFS;  // maze generation algorithm
+  uint32_t seed = 1;                                         // seed of the whole run
+  float max_seconds = 3600.0f;  // simulated time after which an episode counts as unsolved
+  float noise = 0.1f;           // chance of a random move for NOISY_OPTIMAL bots
+  float move_speed = 1.2f;      // walking speed, as in the game
+};
+
+// Outcome of one bot in one maze
+struct EpisodeResult {
+  int maze;           // maze index
+  AgentKind kind;     // bot kind
+  bool solved;        // reached the exit within the time limit
+  int steps;          // physics steps simulated
+  int moves;          // cells walked
+  int optimal_moves;  // length of the shortest path to the exit
+};
+
+// Results of a simulation run
+struct SimulationReport {
+  std::vector<EpisodeResult> episodes;  // every episode, by maze then kind then agent
+  long long total_steps = 0;            // physics steps over all episodes
+  double wall_seconds = 0.0;            // real time spent simulating
+
+  double getStepsPerSecond() const {
+    return wall_seconds > 0.0 ? total_steps / wall_seconds : 0.0;
+  }
+};
+
+// Run every bot of the configuration through every maze, spread over the pool (nullptr: on the
+// calling thread)
+SimulationReport runSimulation(const SimulationConfig& config, ThreadPool* pool = nullptr);
@@ -0,0 +1,27 @@
+#include "flow-field.hpp"
+
+void FlowField::build(const MazeGrid& grid, int target_cell) {
+  target = target_cell;
+  distances.assign(grid.getCellCount(), UNREACHABLE);
+  directions.assign(grid.getCellCount(), NO_DIRECTION);
+  if (target < 0 || target >= grid.getCellCount()) return;
+
+  // distances double as the visited flags, and the queue is a single pass over the cells
+  std::vector<int> queue;
+  queue.reserve(grid.getCellCount());
+  queue.push_back(target);
+  distances[target] = 0;
+
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const int cell = queue[head];
+    for (int dir = TOP; dir <= LEFT; ++dir) {
+      if (grid.hasWall(cell, dir)) continue;
+      const int neighbor = grid.getNeighbor(cell, dir);
+      if (neighbor == MazeGrid::NO_CELL || distances[neighbor] != UNREACHABLE) continue;
+
+      distances[neighbor] = distances[cell] + 1;
+      directions[neighbor] = static_cast<uint8_t>(oppositeDirection(dir));
+      queue.push_back(neighbor);
+    }
+  }
+}
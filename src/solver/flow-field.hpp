@@ -0,0 +1,38 @@
+/*
+Flow Field - Distance and next move to a target cell, for every cell
+
+Built by one breadth-first search from the target over the open walls. Afterwards the distance
+to the target and the first move of a shortest path are a lookup for any cell. The search stays
+serial: perfect mazes are trees whose BFS levels stay narrow (under 2k cells on 4096x4096), too
+narrow for a frontier split across threads to pay for its synchronization.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "maze-generator/maze-grid.hpp"
+
+// FlowField class holding the shortest-path distance and direction to a target
+class FlowField {
+ public:
+  static constexpr int UNREACHABLE = -1;         // distance of cells cut off from the target
+  static constexpr uint8_t NO_DIRECTION = 0xFF;  // direction of the target and cut-off cells
+
+ private:
+  int target = MazeGrid::NO_CELL;   // cell every direction leads to
+  std::vector<int> distances;       // steps to the target, by cell id
+  std::vector<uint8_t> directions;  // first move towards the target, by cell id
+
+ public:
+  // Compute the field towards `target`
+  void build(const MazeGrid& grid, int target);
+
+  bool empty() const { return distances.empty(); }
+  int getTarget() const { return target; }
+  // Steps from a cell to the target, UNREACHABLE if there is no path
+  int getDistance(int cell) const { return distances[cell]; }
+  // Direction of the first move from a cell towards the target, NO_DIRECTION at the target or
+  // when there is no path
+  uint8_t getDirection(int cell) const { return directions[cell]; }
+};
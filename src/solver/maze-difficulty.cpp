@@ -0,0 +1,195 @@
+#include "maze-difficulty.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+#include "maze-solver.hpp"
+
+namespace {
+
+// Openings of a cell by wall mask
+constexpr int OPENINGS[16] = {4, 3, 3, 2, 3, 2, 2, 1, 3, 2, 2, 1, 2, 1, 1, 0};
+
+// Candidates per thread in every round of the targeted generation
+constexpr int CANDIDATES_PER_THREAD = 4;
+// Candidates per thread in every block of the seed scan
+constexpr int SCAN_CANDIDATES_PER_THREAD = 64;
+
+// Scratch of one thread of the targeted generation, reused across candidates
+struct CandidateWorker {
+  MazeGrid grid;
+  MazeSolver solver;
+  std::vector<int> solution;
+  MazeMetrics metrics;  // metrics of the first match of this thread in the current round
+
+  CandidateWorker(int cols, int rows) : grid(cols, rows), solver(grid) {}
+
+  // Generate, solve and analyze the maze of a seed
+  MazeMetrics analyze(GenerationAlgorithm algorithm, uint32_t seed) {
+    grid.reset();
+    generateSeededMaze(grid, algorithm, seed);
+    solver.solve(0, grid.getCellCount() - 1, solution);
+    return analyzeMaze(grid, solution);
+  }
+};
+
+// One scratch per thread of the pool and the calling thread
+std::vector<std::unique_ptr<CandidateWorker>> makeWorkers(int threads, int cols, int rows) {
+  std::vector<std::unique_ptr<CandidateWorker>> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.push_back(std::make_unique<CandidateWorker>(cols, rows));
+  }
+  return workers;
+}
+
+}  // namespace
+
+MazeMetrics analyzeMaze(const MazeGrid& grid, const std::vector<int>& solution) {
+  MazeMetrics metrics;
+
+  // one sweep over the cells
+  for (int cell = 0; cell < grid.getCellCount(); ++cell) {
+    const int openings = OPENINGS[grid.getWalls(cell)];
+    metrics.dead_ends += openings == 1;
+    metrics.junctions += openings >= 3;
+  }
+
+  // one walk along the solution
+  metrics.solution_length = static_cast<int>(solution.size());
+  if (solution.size() < 2) return metrics;
+
+  const int start_x = grid.cellX(solution.front());
+  const int start_y = grid.cellY(solution.front());
+  const int goal_x = grid.cellX(solution.back());
+  const int goal_y = grid.cellY(solution.back());
+  const float line_length = std::hypot(static_cast<float>(goal_x - start_x),
+                                       static_cast<float>(goal_y - start_y));
+
+  int choices = 0;
+  int max_cross = 0;  // largest distance from the line, times line_length
+  for (std::size_t i = 0; i < solution.size(); ++i) {
+    const int cell = solution[i];
+    // every opening but the one the solver came through is a way on; none at the goal
+    if (i + 1 < solution.size()) choices += OPENINGS[grid.getWalls(cell)] - (i > 0 ? 1 : 0);
+    if (i >= 2 && cell - solution[i - 1] != solution[i - 1] - solution[i - 2]) metrics.turns++;
+
+    const int cross = (goal_x - start_x) * (start_y - grid.cellY(cell)) -
+                      (start_x - grid.cellX(cell)) * (goal_y - start_y);
+    max_cross = std::max(max_cross, std::abs(cross));
+  }
+
+  const int moves = metrics.solution_length - 1;
+  const int manhattan = std::abs(goal_x - start_x) + std::abs(goal_y - start_y);
+  metrics.branching_factor = static_cast<float>(choices) / moves;
+  metrics.detour_ratio = manhattan > 0 ? static_cast<float>(moves) / manhattan : 0.0f;
+  metrics.max_deviation = line_length > 0.0f ? max_cross / line_length : 0.0f;
+  return metrics;
+}
+
+bool DifficultyTarget::accepts(const MazeMetrics& metrics) const {
+  return solution_length.contains(static_cast<float>(metrics.solution_length)) &&
+         turns.contains(static_cast<float>(metrics.turns)) &&
+         dead_ends.contains(static_cast<float>(metrics.dead_ends)) &&
+         junctions.contains(static_cast<float>(metrics.junctions)) &&
+         branching_factor.contains(metrics.branching_factor) &&
+         detour_ratio.contains(metrics.detour_ratio) &&
+         max_deviation.contains(metrics.max_deviation);
+}
+
+TargetedMaze generateForTarget(int cols, int rows, GenerationAlgorithm algorithm,
+                               const DifficultyTarget& target, uint32_t first_seed,
+                               int max_candidates, ThreadPool* pool) {
+  const bool parallel = pool && pool->getThreadCount() > 0;
+  const int threads = parallel ? pool->getThreadCount() + 1 : 1;
+  std::vector<std::unique_ptr<CandidateWorker>> workers = makeWorkers(threads, cols, rows);
+
+  TargetedMaze result;
+  std::atomic<int> generated{0};
+  for (int first = 0; first < max_candidates && !result.found;
+       first += threads * CANDIDATES_PER_THREAD) {
+    const int round = std::min(threads * CANDIDATES_PER_THREAD, max_candidates - first);
+    std::atomic<int> best{round};  // lowest matching round index so far
+
+    // thread t tries candidates t, t + threads, ... and stops past the best match, so every
+    // candidate before the first match is always tried
+    auto tryCandidates = [&](int begin, int end) {
+      for (int t = begin; t < end; ++t) {
+        CandidateWorker& worker = *workers[t];
+        for (int k = t; k < round && k < best.load(std::memory_order_relaxed); k += threads) {
+          generated.fetch_add(1, std::memory_order_relaxed);
+          const uint32_t seed = first_seed + static_cast<uint32_t>(first + k);
+          const MazeMetrics metrics = worker.analyze(algorithm, seed);
+          if (!target.accepts(metrics)) continue;
+
+          worker.metrics = metrics;
+          int current = best.load();
+          while (k < current && !best.compare_exchange_weak(current, k)) {
+          }
+          break;
+        }
+      }
+    };
+    if (parallel) {
+      pool->parallelFor(threads, tryCandidates);
+    } else {
+      tryCandidates(0, threads);
+    }
+
+    const int match = best.load();
+    if (match < round) {
+      const CandidateWorker& worker = *workers[match % threads];
+      result.found = true;
+      result.seed = first_seed + static_cast<uint32_t>(first + match);
+      result.metrics = worker.metrics;
+    }
+  }
+  result.candidates = generated.load();
+  return result;
+}
+
+TargetedSeeds findTargetSeeds(int cols, int rows, GenerationAlgorithm algorithm,
+                              const DifficultyTarget& target, uint32_t first_seed, int count,
+                              int max_misses, ThreadPool* pool) {
+  const bool parallel = pool && pool->getThreadCount() > 0;
+  const int threads = parallel ? pool->getThreadCount() + 1 : 1;
+  std::vector<std::unique_ptr<CandidateWorker>> workers = makeWorkers(threads, cols, rows);
+
+  // every seed of a block is tried; only the matches past the last one needed are wasted
+  const int block = threads * SCAN_CANDIDATES_PER_THREAD;
+  std::vector<uint8_t> accepted(block);
+  TargetedSeeds result;
+  uint32_t first = first_seed;  // first seed of the block
+  int misses = 0;               // seeds in a row without a match
+  while (static_cast<int>(result.seeds.size()) < count && misses < max_misses) {
+    // thread t tries seeds t, t + threads, ... of the block
+    auto scanBlock = [&](int begin, int end) {
+      for (int t = begin; t < end; ++t) {
+        CandidateWorker& worker = *workers[t];
+        for (int k = t; k < block; k += threads) {
+          accepted[k] = target.accepts(worker.analyze(algorithm, first + static_cast<uint32_t>(k)));
+        }
+      }
+    };
+    if (parallel) {
+      pool->parallelFor(threads, scanBlock);
+    } else {
+      scanBlock(0, threads);
+    }
+    result.candidates += block;
+
+    // collect the matches in seed order, so the seeds do not depend on the threads
+    for (int k = 0; k < block && misses < max_misses; ++k) {
+      if (!accepted[k]) {
+        misses++;
+        continue;
+      }
+      result.seeds.push_back(first + static_cast<uint32_t>(k));
+      misses = 0;
+      if (static_cast<int>(result.seeds.size()) == count) break;
+    }
+    first += static_cast<uint32_t>(block);
+  }
+  return result;
+}
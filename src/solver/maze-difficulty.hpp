@@ -0,0 +1,84 @@
+/*
+Maze Difficulty - Metrics of a carved maze and generation towards a target difficulty
+
+The analyzer makes one row-major sweep over the cells (dead ends, junctions) and one walk along
+the solution (length, turns, choices met on the way, deviation from the straight line), so it
+costs about as much as reading the walls once. Targeted generation draws candidate seeds,
+generates and analyzes them on a thread pool, and returns the first seed whose maze falls in
+every range of the target; for many mazes, the seeds are scanned once in blocks and the matches
+collected in seed order.
+*/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/generation-strategy.hpp"
+#include "maze-generator/maze-grid.hpp"
+
+// Difficulty metrics of a maze, for the solution from its first cell to its last one
+struct MazeMetrics {
+  int solution_length = 0;        // cells on the solution, both ends included
+  int turns = 0;                  // changes of direction along the solution
+  int dead_ends = 0;              // cells with a single opening
+  int junctions = 0;              // cells with three or four openings
+  float branching_factor = 0.0f;  // mean ways on at every solution cell (1 for a corridor)
+  float detour_ratio = 0.0f;      // solution moves per move of the Manhattan distance
+  float max_deviation = 0.0f;     // farthest solution cell from the start-goal line, in cells
+};
+
+// Analyze a carved grid, given its solution from the first cell to the last one (for example
+// MazeGenerator::getPath())
+MazeMetrics analyzeMaze(const MazeGrid& grid, const std::vector<int>& solution);
+
+// Inclusive range of a metric
+struct MetricRange {
+  float min = 0.0f;
+  float max = std::numeric_limits<float>::max();
+
+  bool contains(float value) const { return value >= min && value <= max; }
+};
+
+// Ranges a maze must fall in; every range is open by default
+struct DifficultyTarget {
+  MetricRange solution_length;
+  MetricRange turns;
+  MetricRange dead_ends;
+  MetricRange junctions;
+  MetricRange branching_factor;
+  MetricRange detour_ratio;
+  MetricRange max_deviation;
+
+  bool accepts(const MazeMetrics& metrics) const;
+};
+
+// Outcome of a targeted generation
+struct TargetedMaze {
+  bool found = false;   // a candidate matched
+  uint32_t seed = 0;    // seed of the matching maze, for MazeGenerator::setSeed()
+  MazeMetrics metrics;  // metrics of the matching maze
+  int candidates = 0;   // candidates generated and analyzed
+};
+
+// Try the seeds first_seed, first_seed + 1, ... (at most max_candidates) in rounds spread over
+// the pool (nullptr: on the calling thread) and return the first that matches the target. The
+// result only depends on the seeds, not on the number of threads.
+TargetedMaze generateForTarget(int cols, int rows, GenerationAlgorithm algorithm,
+                               const DifficultyTarget& target, uint32_t first_seed,
+                               int max_candidates, ThreadPool* pool = nullptr);
+
+// Outcome of a search for several targeted mazes
+struct TargetedSeeds {
+  std::vector<uint32_t> seeds;  // matching seeds, in increasing order
+  long long candidates = 0;     // candidates generated and analyzed
+};
+
+// Scan the seeds first_seed, first_seed + 1, ... in blocks spread over the pool (nullptr: on
+// the calling thread) and collect the first `count` that match the target, in seed order. Stops
+// early after max_misses seeds in a row without a match. The result only depends on the seeds,
+// not on the number of threads.
+TargetedSeeds findTargetSeeds(int cols, int rows, GenerationAlgorithm algorithm,
+                              const DifficultyTarget& target, uint32_t first_seed, int count,
+                              int max_misses, ThreadPool* pool = nullptr);
@@ -0,0 +1,190 @@
+#include "maze-solver.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+MazeSolver::MazeSolver(const MazeGrid& grid)
+    : grid(grid),
+      stamps(grid.getCellCount(), 0),
+      from_dir(grid.getCellCount(), 0),
+      side(grid.getCellCount(), 0),
+      costs(grid.getCellCount(), 0) {}
+
+void MazeSolver::nextStamp() {
+  if (++stamp == 0) {
+    std::fill(stamps.begin(), stamps.end(), 0);
+    stamp = 1;
+  }
+  expanded = 0;
+}
+
+void MazeSolver::traceBack(int cell, int origin, std::vector<int>& path) const {
+  path.push_back(cell);
+  while (cell != origin) {
+    cell = grid.getNeighbor(cell, from_dir[cell]);
+    path.push_back(cell);
+  }
+}
+
+bool MazeSolver::solve(int start, int goal, std::vector<int>& path, SolverAlgorithm algorithm) {
+  path.clear();
+  const int count = grid.getCellCount();
+  if (start < 0 || start >= count || goal < 0 || goal >= count) return false;
+
+  nextStamp();
+  switch (algorithm) {
+    case SolverAlgorithm::A_STAR:
+      return solveAStar(start, goal, path);
+    case SolverAlgorithm::BIDIRECTIONAL_BFS:
+      return solveBidirectional(start, goal, path);
+    default:
+      return solveBfs(start, goal, path);
+  }
+}
+
+bool MazeSolver::solveBfs(int start, int goal, std::vector<int>& path) {
+  queue.clear();
+  queue.push_back(start);
+  reach(start, 0);
+
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const int cell = queue[head];
+    expanded++;
+    if (cell == goal) {
+      traceBack(goal, start, path);
+      std::reverse(path.begin(), path.end());
+      return true;
+    }
+
+    for (int dir = TOP; dir <= LEFT; ++dir) {
+      if (grid.hasWall(cell, dir)) continue;
+      const int neighbor = grid.getNeighbor(cell, dir);
+      if (neighbor == MazeGrid::NO_CELL || reached(neighbor)) continue;
+
+      reach(neighbor, oppositeDirection(dir));
+      queue.push_back(neighbor);
+    }
+  }
+  return false;
+}
+
+bool MazeSolver::solveAStar(int start, int goal, std::vector<int>& path) {
+  const int goal_x = grid.cellX(goal);
+  const int goal_y = grid.cellY(goal);
+  // Manhattan distance never overestimates on a 4-connected grid
+  auto estimate = [&](int cell) {
+    return std::abs(grid.cellX(cell) - goal_x) + std::abs(grid.cellY(cell) - goal_y);
+  };
+  // min-heap on the estimate
+  auto later = std::greater<std::pair<int, int>>();
+
+  heap.clear();
+  heap.emplace_back(estimate(start), start);
+  reach(start, 0);
+  costs[start] = 0;
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const auto [cell_estimate, cell] = heap.back();
+    heap.pop_back();
+    // skip stale entries of cells reached again at a lower cost
+    if (cell_estimate - estimate(cell) > costs[cell]) continue;
+
+    expanded++;
+    if (cell == goal) {
+      traceBack(goal, start, path);
+      std::reverse(path.begin(), path.end());
+      return true;
+    }
+
+    for (int dir = TOP; dir <= LEFT; ++dir) {
+      if (grid.hasWall(cell, dir)) continue;
+      const int neighbor = grid.getNeighbor(cell, dir);
+      if (neighbor == MazeGrid::NO_CELL) continue;
+
+      const int cost = costs[cell] + 1;
+      if (reached(neighbor) && costs[neighbor] <= cost) continue;
+
+      reach(neighbor, oppositeDirection(dir));
+      costs[neighbor] = cost;
+      heap.emplace_back(cost + estimate(neighbor), neighbor);
+      std::push_heap(heap.begin(), heap.end(), later);
+    }
+  }
+  return false;
+}
+
+bool MazeSolver::solveBidirectional(int start, int goal, std::vector<int>& path) {
+  if (start == goal) {
+    path.push_back(start);
+    return true;
+  }
+
+  // queue grows from the start, goal_queue from the goal
+  std::vector<int>* queues[2] = {&queue, &goal_queue};
+  std::size_t head[2] = {0, 0};
+  const int origin[2] = {start, goal};
+  for (int s = 0; s < 2; ++s) {
+    queues[s]->clear();
+    queues[s]->push_back(origin[s]);
+    reach(origin[s], 0);
+    side[origin[s]] = static_cast<uint8_t>(s);
+    costs[origin[s]] = 0;
+  }
+
+  int best_length = -1;  // cells on the shortest path found so far
+  int meet_start = MazeGrid::NO_CELL;
+  int meet_goal = MazeGrid::NO_CELL;
+  while (head[0] < queues[0]->size() && head[1] < queues[1]->size()) {
+    // expand a whole level of the smaller frontier; the best meeting found over the first level
+    // where the searches meet is a shortest path
+    const int s = queues[0]->size() - head[0] <= queues[1]->size() - head[1] ? 0 : 1;
+    std::vector<int>& frontier = *queues[s];
+    const std::size_t level_end = frontier.size();
+    for (; head[s] < level_end; ++head[s]) {
+      const int cell = frontier[head[s]];
+      expanded++;
+
+      for (int dir = TOP; dir <= LEFT; ++dir) {
+        if (grid.hasWall(cell, dir)) continue;
+        const int neighbor = grid.getNeighbor(cell, dir);
+        if (neighbor == MazeGrid::NO_CELL) continue;
+
+        if (!reached(neighbor)) {
+          reach(neighbor, oppositeDirection(dir));
+          side[neighbor] = static_cast<uint8_t>(s);
+          costs[neighbor] = costs[cell] + 1;
+          frontier.push_back(neighbor);
+        } else if (side[neighbor] != s) {
+          const int length = costs[cell] + costs[neighbor] + 2;
+          if (best_length < 0 || length < best_length) {
+            best_length = length;
+            meet_start = s == 0 ? cell : neighbor;
+            meet_goal = s == 0 ? neighbor : cell;
+          }
+        }
+      }
+    }
+    if (best_length >= 0) break;
+  }
+  if (best_length < 0) return false;
+
+  traceBack(meet_start, start, path);
+  std::reverse(path.begin(), path.end());
+  traceBack(meet_goal, goal, path);
+  return true;
+}
+
+std::vector<std::vector<int>> solveBatch(const MazeGrid& grid,
+                                         const std::vector<SolveQuery>& queries,
+                                         ThreadPool& pool, SolverAlgorithm algorithm) {
+  std::vector<std::vector<int>> paths(queries.size());
+  pool.parallelFor(static_cast<int>(queries.size()), [&](int begin, int end) {
+    MazeSolver solver(grid);  // scratch arrays are per thread
+    for (int i = begin; i < end; ++i) {
+      solver.solve(queries[i].start, queries[i].goal, paths[i], algorithm);
+    }
+  });
+  return paths;
+}
@@ -0,0 +1,72 @@
+/*
+Maze Solver - Shortest paths on the wall data
+
+Finds the shortest path between any two cells of a MazeGrid by looking only at its walls, so it
+works for every generation algorithm and any start or goal. The scratch arrays are stamped
+instead of cleared, so repeated queries on one solver cost only the cells they touch.
+*/
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "maze-generator/maze-grid.hpp"
+
+// Path finding algorithms
+enum class SolverAlgorithm {
+  BFS,               // breadth-first search from the start
+  A_STAR,            // best-first search guided by the Manhattan distance to the goal
+  BIDIRECTIONAL_BFS  // breadth-first searches from both ends meeting in the middle
+};
+
+// Start and goal cell of a query
+struct SolveQuery {
+  int start;
+  int goal;
+};
+
+// MazeSolver class answering path queries on one grid (not thread-safe; use one per thread)
+class MazeSolver {
+  const MazeGrid& grid;              // grid to solve
+  std::vector<uint32_t> stamps;      // query stamp of the last query that reached each cell
+  std::vector<uint8_t> from_dir;     // direction back towards the search origin of each cell
+  std::vector<uint8_t> side;         // search side that reached each cell (bidirectional BFS)
+  std::vector<int> costs;            // cost from the search origin of each cell
+  std::vector<int> queue;            // BFS queue (from the start for bidirectional BFS)
+  std::vector<int> goal_queue;       // BFS queue from the goal (bidirectional BFS)
+  std::vector<std::pair<int, int>> heap;  // A* open set as (estimate, cell)
+  uint32_t stamp = 0;                // stamp of the current query
+  int expanded = 0;                  // cells expanded by the last query
+
+  // Start a new query; resets the stamps when the counter wraps around
+  void nextStamp();
+  bool reached(int cell) const { return stamps[cell] == stamp; }
+  void reach(int cell, int dir) {
+    stamps[cell] = stamp;
+    from_dir[cell] = static_cast<uint8_t>(dir);
+  }
+  // Append the cells from `cell` back to the origin of its search, following from_dir
+  void traceBack(int cell, int origin, std::vector<int>& path) const;
+
+  bool solveBfs(int start, int goal, std::vector<int>& path);
+  bool solveAStar(int start, int goal, std::vector<int>& path);
+  bool solveBidirectional(int start, int goal, std::vector<int>& path);
+
+ public:
+  explicit MazeSolver(const MazeGrid& grid);
+
+  // Find the shortest path from start to goal (both included) into `path`; returns false and
+  // leaves `path` empty if the goal cannot be reached
+  bool solve(int start, int goal, std::vector<int>& path,
+             SolverAlgorithm algorithm = SolverAlgorithm::BFS);
+  // Number of cells expanded by the last query
+  int getExpandedCells() const { return expanded; }
+};
+
+// Solve every query in parallel; paths[i] is the path of queries[i], empty if unreachable
+std::vector<std::vector<int>> solveBatch(const MazeGrid& grid,
+                                         const std::vector<SolveQuery>& queries,
+                                         ThreadPool& pool,
+                                         SolverAlgorithm algorithm = SolverAlgorithm::BFS);
@@ -0,0 +1,141 @@
+#include "tree-index.hpp"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Index of the highest set bit (value must not be 0)
+static int highestBit(uint32_t value) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse(&index, value);
+  return static_cast<int>(index);
+#else
+  return 31 - __builtin_clz(value);
+#endif
+}
+
+// Index of the lowest set bit (value must not be 0)
+static int lowestBit(uint32_t value) { return highestBit(value & (~value + 1)); }
+
+TreeIndex::TreeIndex(const MazeGrid& grid) : grid(grid) {
+  const int count = grid.getCellCount();
+  const int root = grid.getRoot();
+  order_index.assign(count, -1);
+  order.reserve(count);
+  order_depth.reserve(count);
+  if (root == MazeGrid::NO_CELL) return;
+
+  // stackless DFS over the parent tree: descend into the next unnumbered child, else go up
+  int cell = root;
+  int depth = 0;
+  order_index[cell] = 0;
+  order.push_back(cell);
+  order_depth.push_back(0);
+  while (cell != MazeGrid::NO_CELL) {
+    int child = MazeGrid::NO_CELL;
+    for (int dir = TOP; dir <= LEFT && child == MazeGrid::NO_CELL; ++dir) {
+      if (grid.hasWall(cell, dir)) continue;
+      const int neighbor = grid.getNeighbor(cell, dir);
+      if (neighbor == MazeGrid::NO_CELL || neighbor == root || order_index[neighbor] >= 0 ||
+          grid.getParentDirection(neighbor) != oppositeDirection(dir)) {
+        continue;
+      }
+      child = neighbor;
+    }
+
+    if (child != MazeGrid::NO_CELL) {
+      depth++;
+      order_index[child] = static_cast<int>(order.size());
+      order.push_back(child);
+      order_depth.push_back(depth);
+      cell = child;
+    } else {
+      depth--;
+      cell = grid.getParent(cell);
+    }
+  }
+
+  // in-block masks: bit k of masks[i] set when position i - k is on the stack of prefix minima
+  // ending at i, so the lowest set bit above the query start is the minimum
+  const int n = static_cast<int>(order.size());
+  masks.resize(n);
+  uint32_t stack = 0;
+  for (int i = 0; i < n; ++i) {
+    stack = i % BLOCK == 0 ? 0 : stack << 1;
+    while (stack && minPosition(i, i - lowestBit(stack)) == i) stack &= stack - 1;
+    stack |= 1;
+    masks[i] = stack;
+  }
+
+  // sparse table over the minimum of every whole block
+  block_count = n / BLOCK;
+  int levels = 1;
+  while ((1 << levels) <= block_count) levels++;
+  block_table.resize(static_cast<std::size_t>(levels) * block_count);
+  for (int b = 0; b < block_count; ++b) {
+    block_table[b] = smallQuery(b * BLOCK + BLOCK - 1);
+  }
+  for (int level = 1; level < levels; ++level) {
+    int* row = &block_table[static_cast<std::size_t>(level) * block_count];
+    const int* previous = row - block_count;
+    for (int b = 0; b + (1 << level) <= block_count; ++b) {
+      row[b] = minPosition(previous[b], previous[b + (1 << (level - 1))]);
+    }
+  }
+}
+
+int TreeIndex::smallQuery(int r, int size) const {
+  const uint32_t window = size >= 32 ? ~0u : (1u << size) - 1;
+  return r - highestBit(masks[r] & window);
+}
+
+int TreeIndex::rangeMinimum(int l, int r) const {
+  if (r - l + 1 <= BLOCK && l / BLOCK == r / BLOCK) return smallQuery(r, r - l + 1);
+
+  // partial blocks at both ends, whole blocks in between
+  const int left = smallQuery(l | (BLOCK - 1), BLOCK - l % BLOCK);
+  const int right = smallQuery(r, r % BLOCK + 1);
+  int best = minPosition(left, right);
+  const int first = l / BLOCK + 1;
+  const int last = r / BLOCK - 1;
+  if (first <= last) {
+    const int level = highestBit(static_cast<uint32_t>(last - first + 1));
+    const int* row = &block_table[static_cast<std::size_t>(level) * block_count];
+    best = minPosition(best, minPosition(row[first], row[last - (1 << level) + 1]));
+  }
+  return best;
+}
+
+int TreeIndex::getLowestCommonAncestor(int a, int b) const {
+  if (a == b) return a;
+  int l = order_index[a];
+  int r = order_index[b];
+  if (l > r) std::swap(l, r);
+  // the shallowest cell after a in DFS order up to b is a child of the common ancestor
+  return grid.getParent(order[rangeMinimum(l + 1, r)]);
+}
+
+int TreeIndex::getDistance(int a, int b) const {
+  return getDepth(a) + getDepth(b) - 2 * getDepth(getLowestCommonAncestor(a, b));
+}
+
+void TreeIndex::getPath(int a, int b, std::vector<int>& path) const {
+  path.clear();
+  const int ancestor = getLowestCommonAncestor(a, b);
+  for (int cell = a; cell != ancestor; cell = grid.getParent(cell)) path.push_back(cell);
+  path.push_back(ancestor);
+
+  // the b side is collected upwards, then reversed in place
+  const std::size_t split = path.size();
+  for (int cell = b; cell != ancestor; cell = grid.getParent(cell)) path.push_back(cell);
+  std::reverse(path.begin() + split, path.end());
+}
+
+std::size_t TreeIndex::getMemoryUsage() const {
+  const std::size_t ints =
+      order_index.capacity() + order.capacity() + order_depth.capacity() + block_table.capacity();
+  return ints * sizeof(int) + masks.capacity() * sizeof(uint32_t);
+}
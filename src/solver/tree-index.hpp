@@ -0,0 +1,49 @@
+/*
+Tree Index - Constant-time distances in a perfect maze
+
+A perfect maze is a spanning tree (the grid's parent codes), so the distance between two cells is
+depth(a) + depth(b) - 2 * depth(lca(a, b)). The lowest common ancestor comes from a range-minimum
+query over the depths in DFS order: a sparse table over blocks of 32 cells plus a 32-bit stack
+mask per cell for the queries inside a block, which keeps the index at O(cells) memory with O(1)
+queries.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "maze-generator/maze-grid.hpp"
+
+// TreeIndex class answering distance and path queries on the parent tree of a completed grid
+class TreeIndex {
+  static constexpr int BLOCK = 32;  // cells per block of the range-minimum structure
+
+  const MazeGrid& grid;             // grid whose parent tree is indexed
+  std::vector<int> order_index;     // position of each cell in DFS order
+  std::vector<int> order;           // cells in DFS order
+  std::vector<int> order_depth;     // depth of the cells in DFS order
+  std::vector<uint32_t> masks;      // in-block minimum stack of each DFS position
+  std::vector<int> block_table;     // sparse table over the block minima (positions)
+  int block_count = 0;              // number of whole blocks
+
+  // Position with the smaller depth
+  int minPosition(int a, int b) const { return order_depth[a] <= order_depth[b] ? a : b; }
+  // Minimum of the `size` positions ending at r, all inside r's block
+  int smallQuery(int r, int size = BLOCK) const;
+  // Position of the minimum depth in [l, r]
+  int rangeMinimum(int l, int r) const;
+
+ public:
+  // Index the parent tree of a completed grid (every cell must be reachable from the root)
+  explicit TreeIndex(const MazeGrid& grid);
+
+  int getDepth(int cell) const { return order_depth[order_index[cell]]; }
+  // Lowest common ancestor of two cells
+  int getLowestCommonAncestor(int a, int b) const;
+  // Number of steps between two cells
+  int getDistance(int a, int b) const;
+  // Cells on the path from a to b, both included, in O(path length)
+  void getPath(int a, int b, std::vector<int>& path) const;
+  // Bytes used by the index
+  std::size_t getMemoryUsage() const;
+};
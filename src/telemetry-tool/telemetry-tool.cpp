@@ -0,0 +1,119 @@
+/*
+NeuroPath telemetry tool
+
+Converts a recorded session to CSV, or replays it against the regenerated maze and checks that
+every replayed position matches the recorded one exactly. A recording with dropped frames cannot
+be replayed exactly and is refused.
+
+Usage: neuropath_telemetry csv FILE [OUT.csv]
+       neuropath_telemetry replay FILE
+*/
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "maze-generator/generation-strategy.hpp"
+#include "telemetry/telemetry-reader.hpp"
+#include "telemetry/telemetry-replay.hpp"
+
+namespace {
+
+int writeCsv(TelemetryReader& reader, const std::string& out_name) {
+  FILE* out = std::fopen(out_name.c_str(), "w");
+  if (!out) {
+    std::fprintf(stderr, "Failed to write %s\n", out_name.c_str());
+    return 1;
+  }
+
+  std::fprintf(out,
+               "frame,frame_time,velocity_x,velocity_z,x,y,z,yaw,pitch,forward,back,left,right,"
+               "run,jump_key,hints,jump,landed,hit_wall,grounded\n");
+  TelemetrySample s;
+  int frames = 0;
+  while (reader.next(s)) {
+    std::fprintf(out, "%u,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g", s.frame, s.frame_time,
+                 s.velocity.x, s.velocity.z, s.position.x, s.position.y, s.position.z, s.yaw,
+                 s.pitch);
+    for (const uint16_t key : {KEY_BIT_FORWARD, KEY_BIT_BACK, KEY_BIT_LEFT, KEY_BIT_RIGHT,
+                               KEY_BIT_RUN, KEY_BIT_JUMP, KEY_BIT_HINTS}) {
+      std::fprintf(out, ",%d", (s.keys & key) != 0);
+    }
+    for (const uint8_t event : {EVENT_JUMP, EVENT_LANDED, EVENT_HIT_WALL, EVENT_GROUNDED}) {
+      std::fprintf(out, ",%d", (s.events & event) != 0);
+    }
+    std::fprintf(out, "\n");
+    frames++;
+  }
+  std::fclose(out);
+  std::printf("%d frames written to %s\n", frames, out_name.c_str());
+  return 0;
+}
+
+int replay(TelemetryReader& reader) {
+  const TelemetryHeader& header = reader.getHeader();
+  std::printf("Replaying a %ux%u %s maze, seed %u\n", header.cols, header.rows,
+              getAlgorithmName(static_cast<GenerationAlgorithm>(header.algorithm)),
+              header.maze_seed);
+  if (header.dropped_samples > 0) {
+    std::fprintf(stderr, "%llu frames dropped while recording, replay not exact\n",
+                 static_cast<unsigned long long>(header.dropped_samples));
+    return 2;
+  }
+
+  TelemetryReplay session(header);
+  TelemetrySample s;
+  int frames = 0;
+  int mismatches = 0;
+  float max_error = 0.0f;
+  uint32_t expected = 0;  // frame number of the next sample
+  while (reader.next(s)) {
+    // files of version 1 do not count the dropped frames, so look for gaps too
+    if (s.frame != expected) {
+      std::fprintf(stderr, "%u frames dropped at frame %u, replay not exact\n",
+                   s.frame - expected, expected);
+      return 2;
+    }
+    expected++;
+    const Vec3& p = session.step(s);
+    const float error = std::fmax(std::fabs(p.x - s.position.x),
+                                  std::fmax(std::fabs(p.y - s.position.y),
+                                            std::fabs(p.z - s.position.z)));
+    if (p.x != s.position.x || p.y != s.position.y || p.z != s.position.z) {
+      if (mismatches == 0) std::printf("First mismatch at frame %u\n", s.frame);
+      mismatches++;
+      max_error = std::fmax(max_error, error);
+    }
+    frames++;
+  }
+  std::printf("%d frames replayed, %d mismatched (max error %g)\n", frames, mismatches,
+              max_error);
+  return mismatches == 0 ? 0 : 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const bool is_csv = argc >= 3 && argc <= 4 && std::strcmp(argv[1], "csv") == 0;
+  const bool is_replay = argc == 3 && std::strcmp(argv[1], "replay") == 0;
+  if (!is_csv && !is_replay) {
+    std::fprintf(stderr, "Usage: %s csv FILE [OUT.csv]\n       %s replay FILE\n", argv[0],
+                 argv[0]);
+    return 1;
+  }
+
+  TelemetryReader reader;
+  if (!reader.open(argv[2])) {
+    std::fprintf(stderr, "%s is not a telemetry file\n", argv[2]);
+    return 1;
+  }
+
+  const int result = is_csv ? writeCsv(reader, argc == 4 ? argv[3] : std::string(argv[2]) + ".csv")
+                            : replay(reader);
+  if (reader.isTruncated()) std::fprintf(stderr, "Warning: the file ends within a frame\n");
+  if (is_csv && reader.getHeader().dropped_samples > 0) {
+    std::fprintf(stderr, "Warning: %llu frames were dropped while recording\n",
+                 static_cast<unsigned long long>(reader.getHeader().dropped_samples));
+  }
+  return result;
+}
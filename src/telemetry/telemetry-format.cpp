@@ -0,0 +1,139 @@
+#include "telemetry-format.hpp"
+
+#include <cstring>
+
+namespace {
+
+void writeVarint(uint64_t value, std::vector<uint8_t>& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+// Read a varint at data[offset]; false if the data ends within it
+bool readVarint(const uint8_t* data, std::size_t size, std::size_t& offset, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (offset >= size) return false;
+    const uint8_t byte = data[offset++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+  return false;
+}
+
+uint32_t floatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float bitsFloat(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Fields written against the previous sample, in file order
+void writeFloat(float value, float previous, std::vector<uint8_t>& out) {
+  writeVarint(floatBits(value) ^ floatBits(previous), out);
+}
+
+bool readFloat(const uint8_t* data, std::size_t size, std::size_t& offset, float previous,
+               float& value) {
+  uint64_t delta;
+  if (!readVarint(data, size, offset, delta)) return false;
+  value = bitsFloat(static_cast<uint32_t>(delta) ^ floatBits(previous));
+  return true;
+}
+
+}  // namespace
+
+void encodeTelemetryHeader(const TelemetryHeader& header, std::vector<uint8_t>& out) {
+  writeVarint(TELEMETRY_MAGIC, out);
+  writeVarint(TELEMETRY_VERSION, out);
+  writeVarint(header.maze_seed, out);
+  writeVarint(header.algorithm, out);
+  writeVarint(header.cols, out);
+  writeVarint(header.rows, out);
+  for (const float value : {header.start.x, header.start.y, header.start.z, header.player_width,
+                            header.player_height, header.player_depth}) {
+    writeVarint(floatBits(value), out);
+  }
+  writeVarint(static_cast<uint64_t>(header.start_time), out);
+  for (int shift = 0; shift < 64; shift += 8) {
+    out.push_back(static_cast<uint8_t>(header.dropped_samples >> shift));
+  }
+}
+
+std::size_t decodeTelemetryHeader(const uint8_t* data, std::size_t size, TelemetryHeader& header) {
+  std::size_t offset = 0;
+  uint64_t fields[13];
+  for (uint64_t& field : fields) {
+    if (!readVarint(data, size, offset, field)) return 0;
+  }
+  if (fields[0] != TELEMETRY_MAGIC || fields[1] == 0 || fields[1] > TELEMETRY_VERSION) return 0;
+
+  header.maze_seed = static_cast<uint32_t>(fields[2]);
+  header.algorithm = static_cast<uint8_t>(fields[3]);
+  header.cols = static_cast<uint16_t>(fields[4]);
+  header.rows = static_cast<uint16_t>(fields[5]);
+  header.start = {bitsFloat(static_cast<uint32_t>(fields[6])),
+                  bitsFloat(static_cast<uint32_t>(fields[7])),
+                  bitsFloat(static_cast<uint32_t>(fields[8]))};
+  header.player_width = bitsFloat(static_cast<uint32_t>(fields[9]));
+  header.player_height = bitsFloat(static_cast<uint32_t>(fields[10]));
+  header.player_depth = bitsFloat(static_cast<uint32_t>(fields[11]));
+  header.start_time = static_cast<int64_t>(fields[12]);
+  header.dropped_samples = 0;
+  if (fields[1] >= 2) {
+    if (size - offset < 8) return 0;
+    for (int shift = 0; shift < 64; shift += 8) {
+      header.dropped_samples |= static_cast<uint64_t>(data[offset++]) << shift;
+    }
+  }
+  return offset;
+}
+
+void TelemetryEncoder::encode(const TelemetrySample& sample, std::vector<uint8_t>& out) {
+  writeVarint(sample.frame - previous.frame, out);
+  writeFloat(sample.frame_time, previous.frame_time, out);
+  writeFloat(sample.velocity.x, previous.velocity.x, out);
+  writeFloat(sample.velocity.z, previous.velocity.z, out);
+  writeFloat(sample.position.x, previous.position.x, out);
+  writeFloat(sample.position.y, previous.position.y, out);
+  writeFloat(sample.position.z, previous.position.z, out);
+  writeFloat(sample.yaw, previous.yaw, out);
+  writeFloat(sample.pitch, previous.pitch, out);
+  writeVarint(sample.keys ^ previous.keys, out);
+  out.push_back(sample.events);
+  previous = sample;
+}
+
+std::size_t TelemetryDecoder::decode(const uint8_t* data, std::size_t size,
+                                     TelemetrySample& sample) {
+  std::size_t offset = 0;
+  TelemetrySample next = previous;
+  uint64_t frame_delta, keys_delta;
+  if (!readVarint(data, size, offset, frame_delta)) return 0;
+  next.frame = previous.frame + static_cast<uint32_t>(frame_delta);
+  if (!readFloat(data, size, offset, previous.frame_time, next.frame_time) ||
+      !readFloat(data, size, offset, previous.velocity.x, next.velocity.x) ||
+      !readFloat(data, size, offset, previous.velocity.z, next.velocity.z) ||
+      !readFloat(data, size, offset, previous.position.x, next.position.x) ||
+      !readFloat(data, size, offset, previous.position.y, next.position.y) ||
+      !readFloat(data, size, offset, previous.position.z, next.position.z) ||
+      !readFloat(data, size, offset, previous.yaw, next.yaw) ||
+      !readFloat(data, size, offset, previous.pitch, next.pitch) ||
+      !readVarint(data, size, offset, keys_delta) || offset >= size) {
+    return 0;
+  }
+  next.keys = previous.keys ^ static_cast<uint16_t>(keys_delta);
+  next.events = data[offset++];
+
+  sample = next;
+  previous = next;
+  return offset;
+}
@@ -0,0 +1,86 @@
+/*
+Telemetry Format - Compact binary recording of a play session
+
+A file is a fixed header (maze and player setup, enough to rebuild the session) followed by one
+record per frame. Records are delta-encoded against the previous one: every float is XORed with
+its previous value and the result is written as a varint, so unchanged values take one byte and
+slowly changing ones a few, while decoding stays bit-exact for replay. The header ends with the
+number of samples the recorder dropped, in fixed width so it can be filled in when it stops.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "utils/types.hpp"
+
+constexpr uint32_t TELEMETRY_MAGIC = 0x4C54504E;  // "NPTL"
+constexpr uint32_t TELEMETRY_VERSION = 2;  // 2: dropped sample count in the header
+
+// Keys held during a frame, as bits of TelemetrySample::keys
+enum TelemetryKey : uint16_t {
+  KEY_BIT_FORWARD = 1 << 0,
+  KEY_BIT_BACK = 1 << 1,
+  KEY_BIT_LEFT = 1 << 2,
+  KEY_BIT_RIGHT = 1 << 3,
+  KEY_BIT_RUN = 1 << 4,
+  KEY_BIT_JUMP = 1 << 5,
+  KEY_BIT_HINTS = 1 << 6
+};
+
+// Events of a frame, as bits of TelemetrySample::events
+enum TelemetryEvent : uint8_t {
+  EVENT_JUMP = 1 << 0,      // a jump was requested
+  EVENT_LANDED = 1 << 1,    // touched the floor after being in the air
+  EVENT_HIT_WALL = 1 << 2,  // stopped by a wall
+  EVENT_GROUNDED = 1 << 3   // standing on the floor at the end of the frame
+};
+
+// Setup of a recorded session
+struct TelemetryHeader {
+  uint32_t maze_seed = 0;           // seed the maze was generated with
+  uint8_t algorithm = 0;            // GenerationAlgorithm of the maze
+  uint16_t cols = 0;                // maze width in cells
+  uint16_t rows = 0;                // maze height in cells
+  Vec3 start = {0.0f, 0.0f, 0.0f};  // player position before the first frame
+  float player_width = 0.0f;        // player box
+  float player_height = 0.0f;
+  float player_depth = 0.0f;
+  int64_t start_time = 0;  // wall-clock start of the session, in seconds since the epoch
+  uint64_t dropped_samples = 0;     // samples the recorder dropped (0 in version 1 files)
+};
+
+// State of one frame
+struct TelemetrySample {
+  uint32_t frame = 0;                  // frame number since the session started
+  float frame_time = 0.0f;             // seconds fed to the physics this frame
+  Vec3 velocity = {0.0f, 0.0f, 0.0f};  // requested walking velocity (y is not recorded)
+  Vec3 position = {0.0f, 0.0f, 0.0f};  // physics position at the end of the frame
+  float yaw = 0.0f;                    // camera yaw in radians
+  float pitch = 0.0f;                  // camera pitch in radians
+  uint16_t keys = 0;                   // TelemetryKey bits
+  uint8_t events = 0;                  // TelemetryEvent bits
+};
+
+// Append the encoded header to a buffer
+void encodeTelemetryHeader(const TelemetryHeader& header, std::vector<uint8_t>& out);
+// Decode a header; returns the bytes read, or 0 if the data is not a valid header
+std::size_t decodeTelemetryHeader(const uint8_t* data, std::size_t size, TelemetryHeader& header);
+
+// TelemetryEncoder class delta-encoding consecutive samples
+class TelemetryEncoder {
+  TelemetrySample previous;  // last encoded sample
+
+ public:
+  // Append the encoded sample to a buffer
+  void encode(const TelemetrySample& sample, std::vector<uint8_t>& out);
+};
+
+// TelemetryDecoder class decoding what TelemetryEncoder wrote
+class TelemetryDecoder {
+  TelemetrySample previous;  // last decoded sample
+
+ public:
+  // Decode one sample; returns the bytes read, or 0 if the data ends within the sample
+  std::size_t decode(const uint8_t* data, std::size_t size, TelemetrySample& sample);
+};
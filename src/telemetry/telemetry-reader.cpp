@@ -0,0 +1,33 @@
+#include "telemetry-reader.hpp"
+
+#include <cstdio>
+
+bool TelemetryReader::open(const std::string& file_name) {
+  FILE* file = std::fopen(file_name.c_str(), "rb");
+  if (!file) return false;
+
+  data.clear();
+  uint8_t chunk[1 << 16];
+  std::size_t read;
+  while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + read);
+  }
+  std::fclose(file);
+
+  decoder = TelemetryDecoder();
+  truncated = false;
+  offset = decodeTelemetryHeader(data.data(), data.size(), header);
+  return offset > 0;
+}
+
+bool TelemetryReader::next(TelemetrySample& sample) {
+  if (offset == 0 || offset >= data.size()) return false;
+  const std::size_t read = decoder.decode(data.data() + offset, data.size() - offset, sample);
+  if (read == 0) {
+    truncated = true;
+    offset = data.size();
+    return false;
+  }
+  offset += read;
+  return true;
+}
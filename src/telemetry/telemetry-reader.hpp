@@ -0,0 +1,30 @@
+/*
+Telemetry Reader - Sequential access to a telemetry file
+
+Loads the whole file (a session is a few hundred kilobytes) and decodes the samples in order.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "telemetry-format.hpp"
+
+// TelemetryReader class decoding a telemetry file
+class TelemetryReader {
+  std::vector<uint8_t> data;  // contents of the file
+  std::size_t offset = 0;     // start of the next sample
+  TelemetryHeader header;
+  TelemetryDecoder decoder;
+  bool truncated = false;     // the file ends within a sample
+
+ public:
+  // Load a file and read its header; false if it cannot be read or is not a telemetry file
+  bool open(const std::string& file_name);
+  const TelemetryHeader& getHeader() const { return header; }
+  // Decode the next sample; false at the end of the file
+  bool next(TelemetrySample& sample);
+  // True if the last sample was cut short (the recording did not stop cleanly)
+  bool isTruncated() const { return truncated; }
+};
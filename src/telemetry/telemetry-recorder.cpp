@@ -0,0 +1,75 @@
+#include "telemetry-recorder.hpp"
+
+#include <chrono>
+
+bool TelemetryRecorder::start(const std::string& file_name, const TelemetryHeader& session) {
+  if (isRecording()) return false;
+
+  file = std::fopen(file_name.c_str(), "wb");
+  if (!file) return false;
+
+  header = session;
+  header.dropped_samples = 0;
+  std::vector<uint8_t> bytes;
+  encodeTelemetryHeader(header, bytes);
+  write_failed = std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size();
+  stopping = false;
+  dropped = 0;
+  writer = std::thread(&TelemetryRecorder::runWriter, this);
+  return true;
+}
+
+bool TelemetryRecorder::record(const TelemetrySample& sample) {
+  if (!isRecording()) return false;
+  if (queue.tryPush(sample)) return true;
+  dropped++;
+  return false;
+}
+
+void TelemetryRecorder::stop() {
+  if (!isRecording()) return;
+  stopping = true;
+  writer.join();
+
+  // the count is fixed-width, so the header keeps its size
+  if (dropped > 0) {
+    header.dropped_samples = dropped;
+    std::vector<uint8_t> bytes;
+    encodeTelemetryHeader(header, bytes);
+    if (std::fseek(file, 0, SEEK_SET) != 0 ||
+        std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+      write_failed = true;
+    }
+  }
+  std::fclose(file);
+  file = nullptr;
+}
+
+void TelemetryRecorder::runWriter() {
+  TelemetryEncoder encoder;
+  std::vector<uint8_t> buffer;
+  buffer.reserve(FLUSH_BYTES + 64);
+
+  auto flush = [&] {
+    if (buffer.empty()) return;
+    if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) write_failed = true;
+    buffer.clear();
+  };
+
+  TelemetrySample sample;
+  while (true) {
+    // read the flag first so the samples queued before stop() are all drained
+    const bool last_pass = stopping;
+    bool popped = false;
+    while (queue.tryPop(sample)) {
+      encoder.encode(sample, buffer);
+      if (buffer.size() >= FLUSH_BYTES) flush();
+      popped = true;
+    }
+    if (last_pass) break;
+    // nothing to do until the next frames; wait without spinning a core
+    if (!popped) std::this_thread::sleep_for(std::chrono::milliseconds(4));
+  }
+  flush();
+  std::fflush(file);
+}
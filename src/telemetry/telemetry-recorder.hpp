@@ -0,0 +1,54 @@
+/*
+Telemetry Recorder - Frame-rate session logging without frame hitches
+
+The simulation hands one sample per tick to a lock-free queue and never waits: if the writer falls
+behind and the queue is full, the sample is dropped and counted, and the count is written into the
+header when the recording stops. A background thread encodes the samples and writes them to disk
+in large blocks.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrency/spsc-queue.hpp"
+#include "telemetry-format.hpp"
+
+// TelemetryRecorder class writing samples to a telemetry file from a background thread
+class TelemetryRecorder {
+  static constexpr std::size_t QUEUE_CAPACITY = 1 << 14;  // about a minute at 240 ticks/s
+  static constexpr std::size_t FLUSH_BYTES = 1 << 16;     // encoded bytes per write
+
+  FILE* file = nullptr;                   // file being written, owned by the writer while it runs
+  TelemetryHeader header;                 // header written at the start of the file
+  SpscQueue<TelemetrySample> queue;       // simulation -> writer samples
+  std::thread writer;                     // writer thread
+  std::atomic<bool> stopping{false};      // writer drains the queue and exits
+  std::atomic<bool> write_failed{false};  // a write to the file failed
+  uint64_t dropped = 0;                   // samples dropped on a full queue
+
+  // Body of the writer thread
+  void runWriter();
+
+ public:
+  TelemetryRecorder() : queue(QUEUE_CAPACITY) {}
+  ~TelemetryRecorder() { stop(); }
+
+  TelemetryRecorder(const TelemetryRecorder&) = delete;
+  TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+  // Create the file, write the header and start the writer; false if the file cannot be created
+  bool start(const std::string& file_name, const TelemetryHeader& header);
+  // Queue the sample of a tick without blocking; false if it was dropped
+  bool record(const TelemetrySample& sample);
+  // Write the queued samples, record the dropped count in the header and close the file
+  void stop();
+
+  bool isRecording() const { return writer.joinable(); }
+  uint64_t getDroppedSamples() const { return dropped; }
+  bool hasFailed() const { return write_failed; }
+};
@@ -0,0 +1,32 @@
+#include "telemetry-replay.hpp"
+
+TelemetryReplay::TelemetryReplay(const TelemetryHeader& header)
+    : maze(header.cols, header.rows),
+      physics(header.start,
+              BoxSize3D(header.player_width, header.player_height, header.player_depth)) {
+  maze.setAlgorithm(static_cast<GenerationAlgorithm>(header.algorithm));
+  maze.setSeed(header.maze_seed);
+  maze.finish_generation();
+}
+
+const Vec3& TelemetryReplay::step(const TelemetrySample& sample) {
+  PlayerInput input;
+  input.velocity = sample.velocity;
+  input.jump = (sample.events & EVENT_JUMP) != 0;
+
+  // same gathering as the game loop, so the physics sees the same boxes in the same order
+  const AABB reach = physics.getReach(sample.frame_time, input);
+  floors.clear();
+  walls.clear();
+  maze.getFloorIndex().forEachNear(reach, [&](const AABB& box) {
+    floors.push_back(box);
+    return false;
+  });
+  maze.getWallIndex().forEachNear(reach, [&](const AABB& box) {
+    walls.push_back(box);
+    return false;
+  });
+
+  physics.update(sample.frame_time, input, floors, walls);
+  return physics.getPosition();
+}
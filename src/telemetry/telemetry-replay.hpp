@@ -0,0 +1,31 @@
+/*
+Telemetry Replay - Re-run a recorded session against the same maze
+
+Regenerates the maze from the seed in the header and feeds the recorded frame times and inputs to
+the same fixed-step physics, gathering the nearby boxes the way the game does. Physics is
+deterministic, so the replayed positions match the recorded ones bit for bit.
+*/
+#pragma once
+
+#include <vector>
+
+#include "maze-generator/maze-generator.hpp"
+#include "physics/player-physics.hpp"
+#include "telemetry-format.hpp"
+
+// TelemetryReplay class replaying the frames of a session
+class TelemetryReplay {
+  MazeGenerator maze;         // the recorded maze, regenerated
+  PlayerPhysics physics;      // replayed player
+  std::vector<AABB> floors;   // boxes within reach this frame
+  std::vector<AABB> walls;
+
+ public:
+  explicit TelemetryReplay(const TelemetryHeader& header);
+
+  // Run the physics of a recorded frame; returns the replayed position
+  const Vec3& step(const TelemetrySample& sample);
+
+  const MazeGenerator& getMaze() const { return maze; }
+  const PlayerPhysics& getPhysics() const { return physics; }
+};
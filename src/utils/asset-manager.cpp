@@ -0,0 +1,228 @@
+#include "asset-manager.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x43504E;  // "NPC"
+constexpr uint32_t CACHE_VERSION = 1;
+
+// Header of a cache file; the decoded data follows it
+struct CacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  int64_t source_time;  // modification time of the source file the cache was made from
+  int32_t fields[4];    // image: width, height, mipmaps, format; wave: frames, rate, bits, channels
+  uint64_t data_size;   // bytes of decoded data
+};
+
+// Modification time of a file, in clock ticks; false if the file does not exist
+bool getSourceTime(const std::string& path, int64_t& source_time) {
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(path, error);
+  source_time = static_cast<int64_t>(time.time_since_epoch().count());
+  return !error;
+}
+
+// Read a cache file made from the current source; data is allocated with MemAlloc
+bool readCache(const std::string& file_name, int64_t source_time, int32_t (&fields)[4],
+               void*& data, uint64_t& data_size) {
+  FILE* file = std::fopen(file_name.c_str(), "rb");
+  if (!file) return false;
+
+  CacheHeader header;
+  bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == CACHE_MAGIC &&
+            header.version == CACHE_VERSION && header.source_time == source_time &&
+            header.data_size > 0;
+  if (ok) {
+    data = MemAlloc(static_cast<unsigned int>(header.data_size));
+    ok = std::fread(data, 1, header.data_size, file) == header.data_size;
+    if (!ok) MemFree(data);
+  }
+  std::fclose(file);
+  if (!ok) return false;
+
+  std::copy(header.fields, header.fields + 4, fields);
+  data_size = header.data_size;
+  return true;
+}
+
+// Write a cache file; a failure only costs the decoding on the next start
+void writeCache(const std::string& file_name, int64_t source_time, const int32_t (&fields)[4],
+                const void* data, uint64_t data_size) {
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(file_name).parent_path(), error);
+
+  // written under a temporary name so a crash never leaves a partial cache file behind
+  const std::string temporary = file_name + ".tmp";
+  FILE* file = std::fopen(temporary.c_str(), "wb");
+  if (!file) return;
+
+  CacheHeader header = {CACHE_MAGIC, CACHE_VERSION, source_time, {}, data_size};
+  std::copy(fields, fields + 4, header.fields);
+  const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  std::fwrite(data, 1, data_size, file) == data_size;
+  std::fclose(file);
+  if (ok) std::filesystem::rename(temporary, file_name, error);
+  if (!ok || error) std::filesystem::remove(temporary, error);
+}
+
+// Bytes of an image with all its mipmap levels
+uint64_t getImageDataSize(const Image& image) {
+  uint64_t size = 0;
+  int width = image.width;
+  int height = image.height;
+  for (int level = 0; level < image.mipmaps; ++level) {
+    size += GetPixelDataSize(width, height, image.format);
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+  }
+  return size;
+}
+
+}  // namespace
+
+AssetManager::AssetManager(ThreadPool& pool, std::string cache_dir)
+    : pool(pool), cache_dir(std::move(cache_dir)) {}
+
+AssetManager::~AssetManager() {
+  // the workers write into the assets; they must be done before the assets go away
+  std::unique_lock<std::mutex> lock(mutex);
+  idle.wait(lock, [&] { return in_flight == 0; });
+  for (const std::unique_ptr<Asset>& asset : assets) {
+    if (asset->state != AssetState::DECODED) continue;
+    if (asset->kind == AssetKind::TEXTURE) UnloadImage(asset->image);
+    if (asset->kind == AssetKind::SOUND) UnloadWave(asset->wave);
+  }
+}
+
+AssetManager::AssetId AssetManager::loadTextureAsync(const std::string& path) {
+  return request(AssetKind::TEXTURE, path);
+}
+
+AssetManager::AssetId AssetManager::loadSoundAsync(const std::string& path) {
+  return request(AssetKind::SOUND, path);
+}
+
+AssetManager::AssetId AssetManager::request(AssetKind kind, const std::string& path) {
+  const AssetId id = static_cast<AssetId>(assets.size());
+  assets.push_back(std::make_unique<Asset>());
+  Asset* asset = assets.back().get();
+  asset->kind = kind;
+  asset->path = path;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    in_flight++;
+  }
+  pool.submit([this, id, asset] { decode(id, *asset); });
+  return id;
+}
+
+std::string AssetManager::getCachePath(const Asset& asset) const {
+  std::string name = asset.path;
+  std::replace_if(
+      name.begin(), name.end(), [](char c) { return c == '/' || c == '\\' || c == ':'; }, '_');
+  return cache_dir + "/" + name + ".npcache";
+}
+
+void AssetManager::decode(AssetId id, Asset& asset) {
+  int64_t source_time = 0;
+  const bool exists = getSourceTime(asset.path, source_time);
+  const std::string cache_path = getCachePath(asset);
+  int32_t fields[4];
+  void* data = nullptr;
+  uint64_t data_size = 0;
+  const bool cached = exists && readCache(cache_path, source_time, fields, data, data_size);
+
+  bool ok = true;
+  if (asset.kind == AssetKind::TEXTURE) {
+    Image& image = asset.image;
+    if (cached) {
+      image = {data, fields[0], fields[1], fields[2], fields[3]};
+    } else {
+      // decode and build the mipmaps here, so the main thread only uploads
+      image = LoadImage(asset.path.c_str());
+      ok = image.data != nullptr;
+      if (ok) {
+        ImageMipmaps(&image);
+        const int32_t image_fields[4] = {image.width, image.height, image.mipmaps, image.format};
+        writeCache(cache_path, source_time, image_fields, image.data, getImageDataSize(image));
+      }
+    }
+  } else {
+    Wave& wave = asset.wave;
+    if (cached) {
+      wave = {static_cast<unsigned int>(fields[0]), static_cast<unsigned int>(fields[1]),
+              static_cast<unsigned int>(fields[2]), static_cast<unsigned int>(fields[3]), data};
+    } else {
+      wave = LoadWave(asset.path.c_str());
+      ok = wave.data != nullptr;
+      if (ok) {
+        const int32_t wave_fields[4] = {
+            static_cast<int32_t>(wave.frameCount), static_cast<int32_t>(wave.sampleRate),
+            static_cast<int32_t>(wave.sampleSize), static_cast<int32_t>(wave.channels)};
+        writeCache(cache_path, source_time, wave_fields, wave.data,
+                   static_cast<uint64_t>(wave.frameCount) * wave.channels * wave.sampleSize / 8);
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    asset.state = ok ? AssetState::DECODED : AssetState::FAILED;
+    decoded.push_back(id);
+    in_flight--;
+    // notified under the lock: the destructor may destroy the condition variable right after
+    idle.notify_all();
+  }
+}
+
+int AssetManager::update(int max_uploads) {
+  std::vector<AssetId> uploads;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const int count = std::min(max_uploads, static_cast<int>(decoded.size()));
+    uploads.assign(decoded.begin(), decoded.begin() + count);
+    decoded.erase(decoded.begin(), decoded.begin() + count);
+  }
+
+  for (const AssetId id : uploads) {
+    Asset& asset = *assets[id];
+    if (asset.state == AssetState::FAILED) {
+      TraceLog(LOG_WARNING, "Failed to load %s", asset.path.c_str());
+    } else if (asset.kind == AssetKind::TEXTURE) {
+      asset.texture = LoadTextureFromImage(asset.image);
+      SetTextureFilter(asset.texture, TEXTURE_FILTER_TRILINEAR);
+      UnloadImage(asset.image);
+      asset.image = {};
+      asset.state = AssetState::READY;
+    } else {
+      asset.sound = LoadSoundFromWave(asset.wave);
+      UnloadWave(asset.wave);
+      asset.wave = {};
+      asset.state = AssetState::READY;
+    }
+    ready++;
+  }
+  return static_cast<int>(uploads.size());
+}
+
+float AssetManager::getProgress() const {
+  return assets.empty() ? 1.0f : static_cast<float>(ready) / assets.size();
+}
+
+void AssetManager::unload() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const std::unique_ptr<Asset>& asset : assets) {
+    if (asset->state != AssetState::READY) continue;
+    if (asset->kind == AssetKind::TEXTURE) UnloadTexture(asset->texture);
+    if (asset->kind == AssetKind::SOUND) UnloadSound(asset->sound);
+    asset->texture = {};
+    asset->sound = {};
+    asset->state = AssetState::UNLOADED;
+  }
+}
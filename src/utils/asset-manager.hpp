@@ -0,0 +1,83 @@
+/*
+Asset Manager - Textures and sounds loaded off the main thread
+
+Image and audio files are decoded on worker threads; the main thread only uploads the decoded
+data (textures to the GPU, waves to the audio device), a few assets per frame, so the first frame
+is drawn right away. Decoded assets, with their mipmaps, are cached as raw files next to the
+game and read back directly on the next start, unless the source file changed.
+*/
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "concurrency/thread-pool.hpp"
+#include "raylib.h"
+
+// AssetManager class loading textures and sounds asynchronously
+class AssetManager {
+ public:
+  using AssetId = int;
+  static constexpr int MAX_UPLOADS_PER_FRAME = 2;  // uploads per update(), to avoid hitches
+
+ private:
+  enum class AssetKind { TEXTURE, SOUND };
+  enum class AssetState { DECODING, DECODED, READY, FAILED, UNLOADED };
+
+  struct Asset {
+    AssetKind kind;
+    std::string path;
+    AssetState state = AssetState::DECODING;
+    Image image = {};      // decoded texture, until uploaded
+    Wave wave = {};        // decoded sound, until uploaded
+    Texture2D texture = {};
+    Sound sound = {};
+  };
+
+  ThreadPool& pool;                            // decoding workers
+  std::string cache_dir;                       // directory of the decoded asset cache
+  std::vector<std::unique_ptr<Asset>> assets;  // every requested asset, by id (stable addresses)
+  std::mutex mutex;                            // guards decoded, in_flight and asset states
+  std::condition_variable idle;                // signalled when a decode finishes
+  std::vector<AssetId> decoded;                // decoded assets waiting for their upload
+  int in_flight = 0;                           // decodes not finished yet
+  int ready = 0;                               // assets uploaded or failed
+
+  // Request an asset and queue its decoding
+  AssetId request(AssetKind kind, const std::string& path);
+  // Decode an asset, from the cache when it is up to date (worker thread)
+  void decode(AssetId id, Asset& asset);
+  // Path of the cache file of an asset
+  std::string getCachePath(const Asset& asset) const;
+
+ public:
+  explicit AssetManager(ThreadPool& pool, std::string cache_dir = "cache");
+  // Waits for the decodes in flight; unload() must have been called while the window is open
+  ~AssetManager();
+
+  AssetManager(const AssetManager&) = delete;
+  AssetManager& operator=(const AssetManager&) = delete;
+
+  // Start loading a texture (with mipmaps, trilinear filtering) or a sound
+  AssetId loadTextureAsync(const std::string& path);
+  AssetId loadSoundAsync(const std::string& path);
+
+  // Upload up to max_uploads decoded assets (main thread); returns the number uploaded
+  int update(int max_uploads = MAX_UPLOADS_PER_FRAME);
+
+  bool isLoading() const { return ready < static_cast<int>(assets.size()); }
+  // Share of the requested assets that are ready, in [0, 1]
+  float getProgress() const;
+
+  // The asset, or an empty one until it is ready; the reference stays valid and is filled in
+  // place once the asset is uploaded
+  const Texture2D& getTexture(AssetId id) const { return assets[id]->texture; }
+  const Sound& getSound(AssetId id) const { return assets[id]->sound; }
+
+  // Release every uploaded asset (before closing the window and the audio device)
+  void unload();
+};
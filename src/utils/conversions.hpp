@@ -0,0 +1,17 @@
+#pragma once
+
+#include "raylib.h"
+#include "utils/types.hpp"
+
+// Conversions between the raylib-free core types and raylib types
+namespace helper {
+inline Vector3 toVector3(const Vec3& v) { return {v.x, v.y, v.z}; }
+
+inline Vec3 toVec3(const Vector3& v) { return {v.x, v.y, v.z}; }
+
+inline BoundingBox toBoundingBox(const AABB& box) {
+  return {toVector3(box.min), toVector3(box.max)};
+}
+
+inline AABB toAABB(const BoundingBox& box) { return {toVec3(box.min), toVec3(box.max)}; }
+}  // namespace helper
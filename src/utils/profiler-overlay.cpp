@@ -0,0 +1,37 @@
+#include "profiler-overlay.hpp"
+
+#include "raylib.h"
+
+namespace neuro_path_profiler {
+void DrawProfilerOverlay(const FrameProfiler& profiler, int x, int y) {
+  const int FONT_SIZE = 10;
+  const int LINE_HEIGHT = 12;
+  const int P50_COLUMN = 110;  // the default font is proportional, so columns are placed by hand
+  const int P99_COLUMN = 160;
+  const int WIDTH = 210;
+  const int HEIGHT = (PROFILE_PHASE_COUNT + 3) * LINE_HEIGHT + 8;
+
+  DrawRectangle(x, y, WIDTH, HEIGHT, Fade(BLACK, 0.7f));
+  x += 6;
+  y += 4;
+
+  auto drawRow = [&](const char* name, const char* p50, const char* p99, Color color) {
+    DrawText(name, x, y, FONT_SIZE, color);
+    DrawText(p50, x + P50_COLUMN, y, FONT_SIZE, color);
+    DrawText(p99, x + P99_COLUMN, y, FONT_SIZE, color);
+    y += LINE_HEIGHT;
+  };
+  auto drawStats = [&](const char* name, const PhaseStats& stats) {
+    drawRow(name, TextFormat("%.2f", stats.p50), TextFormat("%.2f", stats.p99), WHITE);
+  };
+
+  drawRow("phase (ms)", "p50", "p99", YELLOW);
+  drawStats("frame", profiler.getFrameStats());
+  for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+    const ProfilePhase phase = static_cast<ProfilePhase>(p);
+    drawStats(getPhaseName(phase), profiler.getPhaseStats(phase));
+  }
+  DrawText(TextFormat("%d frames, F3 to hide", profiler.getRecordedFrames()), x, y, FONT_SIZE,
+           GRAY);
+}
+}  // namespace neuro_path_profiler
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "profiler/frame-profiler.hpp"
+
+namespace neuro_path_profiler {
+// Draw the p50/p99 of the frame and of every phase, in milliseconds, with its top-left at (x, y)
+void DrawProfilerOverlay(const FrameProfiler& profiler, int x, int y);
+}  // namespace neuro_path_profiler
@@ -0,0 +1,10 @@
+#pragma once
+#include <random>
+
+namespace helper {
+// Get a random index in [0, count) from the given generator
+inline int getRandomIndex(std::mt19937& gen, int count) {
+  std::uniform_int_distribution<> distrib(0, count - 1);
+  return distrib(gen);
+}
+}  // namespace helper
@@ -8,3 +8,24 @@ struct BoxSize3D {
   float depth;
   BoxSize3D(float w, float h, float d) : width(w), height(h), depth(d) {}
 };
+
+// Structure representing a point in 3D space
+// (same layout as raylib's Vector3, without depending on raylib)
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+// Structure representing an axis-aligned bounding box
+// (same layout as raylib's BoundingBox)
+struct AABB {
+  Vec3 min;
+  Vec3 max;
+};
+
+// Check if two bounding boxes overlap
+inline bool checkCollision(const AABB& a, const AABB& b) {
+  return a.max.x >= b.min.x && a.min.x <= b.max.x && a.max.y >= b.min.y && a.min.y <= b.max.y &&
+         a.max.z >= b.min.z && a.min.z <= b.max.z;
+}
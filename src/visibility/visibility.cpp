@@ -0,0 +1,195 @@
+#include "visibility.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float PI_F = 3.14159265358979323846f;
+
+Vec3 sub(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+Vec3 add(const Vec3& a, const Vec3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+Vec3 scale(const Vec3& a, float s) { return {a.x * s, a.y * s, a.z * s}; }
+float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+Vec3 cross(const Vec3& a, const Vec3& b) {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+Vec3 normalize(const Vec3& a) {
+  const float length = std::sqrt(dot(a, a));
+  return length > 0.0f ? scale(a, 1.0f / length) : a;
+}
+
+// Angular interval of view angles, relative to the view direction
+struct Interval {
+  float lo;
+  float hi;
+  bool empty() const { return lo > hi; }
+};
+
+// Intersect an interval with the angles subtended by a portal segment
+Interval clip(const Interval& parent, float a0, float a1) {
+  const float lo = std::min(a0, a1);
+  const float hi = std::max(a0, a1);
+  if (hi - lo <= PI_F) {
+    return {std::max(parent.lo, lo), std::min(parent.hi, hi)};
+  }
+
+  // the portal wraps around behind the viewer: it covers [hi, PI] and [-PI, lo]
+  const Interval upper = {std::max(parent.lo, hi), parent.hi};
+  const Interval lower = {parent.lo, std::min(parent.hi, lo)};
+  if (upper.empty()) return lower;
+  if (lower.empty()) return upper;
+  return {lower.lo, upper.hi};  // conservative hull of both parts
+}
+}  // namespace
+
+Frustum::Frustum(const ViewParams& view) {
+  const Vec3 forward = normalize(sub(view.target, view.position));
+  const Vec3 right = normalize(cross(forward, view.up));
+  const Vec3 up = cross(right, forward);
+
+  const float half_v = view.fovy * PI_F / 180.0f / 2;
+  const float half_h = std::atan(std::tan(half_v) * view.aspect);
+
+  const Vec3 normals[6] = {
+      forward,                                                                 // near
+      scale(forward, -1.0f),                                                   // far
+      add(scale(right, std::cos(half_h)), scale(forward, std::sin(half_h))),   // left
+      add(scale(right, -std::cos(half_h)), scale(forward, std::sin(half_h))),  // right
+      add(scale(up, std::cos(half_v)), scale(forward, std::sin(half_v))),      // bottom
+      add(scale(up, -std::cos(half_v)), scale(forward, std::sin(half_v))),     // top
+  };
+  const Vec3 points[6] = {
+      add(view.position, scale(forward, view.near_clip)),
+      add(view.position, scale(forward, view.far_clip)),
+      view.position,
+      view.position,
+      view.position,
+      view.position,
+  };
+
+  for (int i = 0; i < 6; ++i) {
+    planes[i][0] = normals[i].x;
+    planes[i][1] = normals[i].y;
+    planes[i][2] = normals[i].z;
+    planes[i][3] = -dot(normals[i], points[i]);
+  }
+}
+
+bool Frustum::intersects(const AABB& box) const {
+  for (const auto& plane : planes) {
+    // corner of the box furthest along the plane normal
+    const float x = plane[0] >= 0.0f ? box.max.x : box.min.x;
+    const float y = plane[1] >= 0.0f ? box.max.y : box.min.y;
+    const float z = plane[2] >= 0.0f ? box.max.z : box.min.z;
+    if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) return false;
+  }
+  return true;
+}
+
+void PortalCuller::compute(const MazeGrid& grid, const BoxSize3D& cell_size,
+                           const ViewParams& view) {
+  const int cell_count = grid.getCellCount();
+  if (static_cast<int>(stamp.size()) != cell_count) {
+    interval_lo.assign(cell_count, 0.0f);
+    interval_hi.assign(cell_count, 0.0f);
+    stamp.assign(cell_count, 0);
+    frame = 0;
+  }
+  if (++frame == 0) {  // stamp wrapped around, start over
+    std::fill(stamp.begin(), stamp.end(), 0);
+    frame = 1;
+  }
+  visible.clear();
+  queue.clear();
+
+  const int eye_x = static_cast<int>(std::floor(view.position.x / cell_size.width + 0.5f));
+  const int eye_z = static_cast<int>(std::floor(view.position.z / cell_size.depth + 0.5f));
+  if (eye_x < 0 || eye_x >= grid.getCols() || eye_z < 0 || eye_z >= grid.getRows()) return;
+
+  // horizontal view direction and half field of view, widened for the pitch of the camera
+  const Vec3 forward = normalize(sub(view.target, view.position));
+  const float yaw = std::atan2(forward.x, forward.z);
+  const float pitch = std::asin(std::clamp(forward.y, -1.0f, 1.0f));
+  const float half_v = view.fovy * PI_F / 180.0f / 2;
+  const float half_h = std::atan(std::tan(half_v) * view.aspect);
+  float half_angle =
+      std::atan2(std::tan(half_h) * std::cos(half_v), std::cos(std::fabs(pitch) + half_v));
+  if (half_angle >= PI_F / 2) half_angle = PI_F;  // looking steeply down: every direction counts
+
+  const float dir_x = std::sin(yaw);
+  const float dir_z = std::cos(yaw);
+  // view angle of a point on the ground plane, relative to the view direction
+  auto angleOf = [&](float x, float z) {
+    const float dx = x - view.position.x;
+    const float dz = z - view.position.z;
+    return std::atan2(dx * dir_z - dz * dir_x, dx * dir_x + dz * dir_z);
+  };
+
+  const float far_sq = view.far_clip * view.far_clip;
+  const float near_portal = 1e-3f;  // portals closer than this pass the interval unchanged
+
+  const int start = grid.cellId(eye_x, eye_z);
+  stamp[start] = frame;
+  interval_lo[start] = -half_angle;
+  interval_hi[start] = half_angle;
+  queue.push_back(start);
+  visible.push_back(start);
+
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const int cell = queue[head];
+    const Interval parent = {interval_lo[cell], interval_hi[cell]};
+    const float cx = grid.cellX(cell) * cell_size.width;
+    const float cz = grid.cellY(cell) * cell_size.depth;
+
+    for (int dir = TOP; dir <= LEFT; ++dir) {
+      if (grid.hasWall(cell, dir)) continue;
+      const int neighbor = grid.getNeighbor(cell, dir);
+      if (neighbor == MazeGrid::NO_CELL) continue;
+
+      // endpoints of the opening on the shared edge
+      const float hw = cell_size.width / 2;
+      const float hd = cell_size.depth / 2;
+      float x0, z0, x1, z1;
+      switch (dir) {
+        case TOP:
+          x0 = cx - hw, z0 = cz - hd, x1 = cx + hw, z1 = cz - hd;
+          break;
+        case RIGHT:
+          x0 = cx + hw, z0 = cz - hd, x1 = cx + hw, z1 = cz + hd;
+          break;
+        case BOTTOM:
+          x0 = cx - hw, z0 = cz + hd, x1 = cx + hw, z1 = cz + hd;
+          break;
+        default:
+          x0 = cx - hw, z0 = cz - hd, x1 = cx - hw, z1 = cz + hd;
+          break;
+      }
+
+      // skip openings beyond the far plane
+      const float mx = (x0 + x1) / 2 - view.position.x;
+      const float mz = (z0 + z1) / 2 - view.position.z;
+      if (mx * mx + mz * mz > far_sq) continue;
+
+      // distance from the eye to the line of the opening
+      const bool vertical_edge = (dir == RIGHT || dir == LEFT);
+      const float edge_distance =
+          vertical_edge ? std::fabs(x0 - view.position.x) : std::fabs(z0 - view.position.z);
+      const Interval clipped =
+          edge_distance < near_portal ? parent : clip(parent, angleOf(x0, z0), angleOf(x1, z1));
+      if (clipped.empty()) continue;
+
+      if (stamp[neighbor] != frame) {
+        stamp[neighbor] = frame;
+        interval_lo[neighbor] = clipped.lo;
+        interval_hi[neighbor] = clipped.hi;
+        visible.push_back(neighbor);
+        queue.push_back(neighbor);
+      } else if (clipped.lo < interval_lo[neighbor] || clipped.hi > interval_hi[neighbor]) {
+        // reached again through another opening (mazes with loops): widen and revisit
+        interval_lo[neighbor] = std::min(interval_lo[neighbor], clipped.lo);
+        interval_hi[neighbor] = std::max(interval_hi[neighbor], clipped.hi);
+        queue.push_back(neighbor);
+      }
+    }
+  }
+}
@@ -0,0 +1,52 @@
+/*
+Visibility - Frustum and portal culling
+
+Frustum tests whole chunks against the camera view volume. PortalCuller walks the maze from the
+camera's cell through open walls (portals), narrowing the horizontal view angle at every opening,
+so only cells that can be seen through a chain of openings are marked visible.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "maze-generator/maze-grid.hpp"
+#include "utils/types.hpp"
+
+// Camera parameters needed for culling
+struct ViewParams {
+  Vec3 position;    // eye position
+  Vec3 target;      // point looked at
+  Vec3 up;          // up vector
+  float fovy;       // vertical field of view in degrees
+  float aspect;     // viewport width / height
+  float near_clip;  // near plane distance
+  float far_clip;   // far plane distance
+};
+
+// Frustum class testing bounding boxes against the six planes of a view volume
+class Frustum {
+  float planes[6][4];  // inward facing planes (a, b, c, d) with a*x + b*y + c*z + d >= 0 inside
+
+ public:
+  Frustum(const ViewParams& view);
+
+  // Check if a box is at least partly inside the frustum
+  bool intersects(const AABB& box) const;
+};
+
+// PortalCuller class finding the cells visible from the camera through open walls
+class PortalCuller {
+  std::vector<float> interval_lo;  // lowest visible view angle into each reached cell
+  std::vector<float> interval_hi;  // highest visible view angle into each reached cell
+  std::vector<uint32_t> stamp;     // frame stamp of each cell, to skip clearing the arrays
+  uint32_t frame = 0;              // current frame stamp
+  std::vector<int> queue;          // cells waiting to be expanded
+  std::vector<int> visible;        // cells reached this frame
+
+ public:
+  // Walk the maze from the camera's cell; cell (0, 0) is centered on the origin
+  void compute(const MazeGrid& grid, const BoxSize3D& cell_size, const ViewParams& view);
+
+  const std::vector<int>& getVisibleCells() const { return visible; }
+};